@@ -0,0 +1,355 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <bitcoin/node.hpp>
+#if !defined(HAVE_MSC)
+    #include <sys/resource.h>
+#endif
+
+// Block deserialization allocator benchmark.
+//
+// usage: libbitcoin-node-bench <block|default|pmr> [directory] [iterations]
+//
+// Each file in directory is a raw (binary) wire block, such as obtained from
+// the getblock RPC with verbosity zero (hex decoded). If directory is omitted
+// a synthetic corpus of mainnet-sized (~1.5MB, ~4000 tx) blocks is generated.
+// Run one allocator per process, as peak resident set size is per process.
+
+using namespace bc;
+using namespace bc::system;
+using namespace bc::node;
+using clock_type = std::chrono::steady_clock;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+constexpr size_t multiple = 20;
+constexpr size_t synthetic_blocks = 32;
+constexpr size_t synthetic_transactions = 4'000;
+constexpr size_t default_iterations = 10;
+
+// Forwards to an arena, counting allocations.
+class counting_arena
+  : public arena
+{
+public:
+    counting_arena(arena& inner) NOEXCEPT
+      : inner_(inner)
+    {
+    }
+
+    void* start(size_t wire_size) THROWS override
+    {
+        return inner_.start(wire_size);
+    }
+
+    size_t detach() NOEXCEPT override
+    {
+        return inner_.detach();
+    }
+
+    void release(void* address) NOEXCEPT override
+    {
+        inner_.release(address);
+    }
+
+    size_t allocations{};
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) THROWS override
+    {
+        ++allocations;
+        return inner_.allocate(bytes, align);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t align) NOEXCEPT override
+    {
+        inner_.deallocate(ptr, bytes, align);
+    }
+
+    bool do_is_equal(const arena& other) const NOEXCEPT override
+    {
+        return &other == this;
+    }
+
+private:
+    arena& inner_;
+};
+
+// A monotonic buffer resource per block, released as a whole.
+class pmr_arena
+  : public arena
+{
+public:
+    void* start(size_t wire_size) THROWS override
+    {
+        auto resource = std::make_unique<std::pmr::monotonic_buffer_resource>(
+            ceilinged_multiply(wire_size, multiple));
+
+        current_ = resource.get();
+        resources_.emplace(current_, std::move(resource));
+        return current_;
+    }
+
+    size_t detach() NOEXCEPT override
+    {
+        current_ = nullptr;
+        return zero;
+    }
+
+    void release(void* address) NOEXCEPT override
+    {
+        resources_.erase(address);
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) THROWS override
+    {
+        return current_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void*, size_t, size_t) NOEXCEPT override
+    {
+    }
+
+    bool do_is_equal(const arena& other) const NOEXCEPT override
+    {
+        return &other == this;
+    }
+
+private:
+    std::pmr::monotonic_buffer_resource* current_{};
+    std::unordered_map<void*, std::unique_ptr<
+        std::pmr::monotonic_buffer_resource>> resources_{};
+};
+
+// Deterministic mainnet-sized legacy blocks (two-in, two-out p2pkh txs).
+std::vector<data_chunk> synthesize() NOEXCEPT
+{
+    uint32_t seed{ 42 };
+    const auto next = [&]() NOEXCEPT
+    {
+        seed = seed * 1'103'515'245u + 12'345u;
+        return narrow_cast<uint8_t>(seed >> 16);
+    };
+
+    std::vector<data_chunk> corpus(synthetic_blocks);
+    for (auto& block: corpus)
+    {
+        data_chunk out{};
+        const auto bytes = [&](size_t count) NOEXCEPT
+        {
+            for (size_t byte = 0; byte < count; ++byte)
+                out.push_back(next());
+        };
+        const auto little = [&](uint64_t value, size_t count) NOEXCEPT
+        {
+            for (size_t byte = 0; byte < count; ++byte)
+                out.push_back(narrow_cast<uint8_t>(value >> (byte * 8u)));
+        };
+
+        // Header (values are not validated).
+        bytes(80);
+
+        // Transaction count (0xfd is varint uint16_t).
+        out.push_back(0xfd);
+        little(synthetic_transactions, 2);
+
+        for (size_t tx = 0; tx < synthetic_transactions; ++tx)
+        {
+            little(1, 4);
+            out.push_back(2);
+            for (auto input = 0; input < 2; ++input)
+            {
+                bytes(32);
+                little(input, 4);
+                out.push_back(107);
+                bytes(107);
+                little(max_uint32, 4);
+            }
+
+            out.push_back(2);
+            for (auto output = 0; output < 2; ++output)
+            {
+                little(50'000, 8);
+                out.push_back(25);
+                out.insert(out.end(), { 0x76, 0xa9, 0x14 });
+                bytes(20);
+                out.insert(out.end(), { 0x88, 0xac });
+            }
+
+            little(0, 4);
+        }
+
+        block = std::move(out);
+    }
+
+    return corpus;
+}
+
+std::vector<data_chunk> load(const std::filesystem::path& directory) NOEXCEPT
+{
+    std::vector<data_chunk> corpus{};
+    for (const auto& entry: std::filesystem::directory_iterator(directory))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        std::ifstream file{ entry.path(), std::ios::binary };
+        corpus.emplace_back(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+    }
+
+    return corpus;
+}
+
+size_t peak_rss_kb() NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    return zero;
+#else
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return possible_narrow_sign_cast<size_t>(usage.ru_maxrss);
+#endif
+}
+
+double seconds(clock_type::duration duration) NOEXCEPT
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: libbitcoin-node-bench <block|default|pmr> "
+            "[directory] [iterations]" << std::endl;
+        return -1;
+    }
+
+    const std::string name{ argv[1] };
+    const auto corpus = argc > 2 ? load(argv[2]) : synthesize();
+    const auto iterations = argc > 3 ? std::stoul(argv[3]) :
+        default_iterations;
+
+    block_arena block{ multiple };
+    pmr_arena pmr{};
+    arena* inner{};
+
+    if (name == "block")
+        inner = &block;
+    else if (name == "default")
+        inner = default_arena::get();
+    else if (name == "pmr")
+        inner = &pmr;
+    else
+    {
+        std::cerr << "unknown allocator: " << name << std::endl;
+        return -1;
+    }
+
+    if (corpus.empty())
+    {
+        std::cerr << "empty corpus" << std::endl;
+        return -1;
+    }
+
+    counting_arena counter{ *inner };
+    clock_type::duration deserialize{};
+    clock_type::duration release{};
+    size_t blocks{};
+    size_t bytes{};
+
+    struct held
+    {
+        chain::block* block;
+        void* memory;
+    };
+
+    std::vector<held> retained{};
+    retained.reserve(corpus.size());
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        // All blocks of the corpus are held at once, as in a download window.
+        const auto start = clock_type::now();
+        for (const auto& data: corpus)
+        {
+            const auto memory = counter.start(data.size());
+            stream::in::fast source{ data };
+            read::bytes::fast reader{ source, &counter };
+            const auto raw = reader.get_allocator().new_object<chain::block>(
+                reader, true);
+            bytes += data.size();
+            counter.detach();
+
+            if (is_null(raw) || !reader || !raw->is_valid())
+            {
+                std::cerr << "invalid block in corpus" << std::endl;
+                return -1;
+            }
+
+            retained.push_back({ raw, memory });
+        }
+
+        // Destruct (piecewise for default arena, nop for linear arenas).
+        const auto stop = clock_type::now();
+        for (const auto& item: retained)
+        {
+            std::destroy_at(item.block);
+            counter.deallocate(item.block, sizeof(chain::block),
+                alignof(chain::block));
+            counter.release(item.memory);
+        }
+
+        release += clock_type::now() - stop;
+        deserialize += stop - start;
+        blocks += retained.size();
+        retained.clear();
+    }
+
+    const auto deserialize_seconds = seconds(deserialize);
+    const auto release_seconds = seconds(release);
+    std::cout
+        << "allocator            : " << name << std::endl
+        << "blocks               : " << blocks << std::endl
+        << "wire bytes           : " << bytes << std::endl
+        << "allocations          : " << counter.allocations << std::endl
+        << "allocations/second   : " << (counter.allocations /
+            deserialize_seconds) << std::endl
+        << "blocks/second        : " << (blocks / deserialize_seconds)
+            << std::endl
+        << "release (total ms)   : " << (release_seconds * 1000.0)
+            << std::endl
+        << "release (block us)   : " << (release_seconds * 1'000'000.0 /
+            blocks) << std::endl
+        << "peak rss (kb)        : " << peak_rss_kb() << std::endl;
+
+    return 0;
+}
+
+BC_POP_WARNING()
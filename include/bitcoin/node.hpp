@@ -18,18 +18,25 @@
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/block_arena.hpp>
 #include <bitcoin/node/block_memory.hpp>
+#include <bitcoin/node/block_prefetch.hpp>
+#include <bitcoin/node/block_sizes.hpp>
+#include <bitcoin/node/channel_speeds.hpp>
 #include <bitcoin/node/chase.hpp>
+#include <bitcoin/node/chunk_pool.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/error.hpp>
 #include <bitcoin/node/events.hpp>
 #include <bitcoin/node/full_node.hpp>
+#include <bitcoin/node/height_bitmap.hpp>
+#include <bitcoin/node/peer_history.hpp>
 #include <bitcoin/node/settings.hpp>
 #include <bitcoin/node/version.hpp>
 #include <bitcoin/node/channels/channel.hpp>
 #include <bitcoin/node/channels/channel_peer.hpp>
 #include <bitcoin/node/channels/channels.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/chasers/chaser_archive.hpp>
 #include <bitcoin/node/chasers/chaser_block.hpp>
 #include <bitcoin/node/chasers/chaser_check.hpp>
 #include <bitcoin/node/chasers/chaser_confirm.hpp>
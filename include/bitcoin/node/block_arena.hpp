@@ -19,6 +19,10 @@
 #ifndef LIBBITCOIN_NODE_BLOCK_ARENA_HPP
 #define LIBBITCOIN_NODE_BLOCK_ARENA_HPP
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <bitcoin/node/chunk_pool.hpp>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -31,7 +35,17 @@ class BCN_API block_arena
 public:
     DELETE_COPY(block_arena);
     
-    block_arena(size_t multiple) NOEXCEPT;
+    /// Released chunks are retained for reuse up to retain bytes (if nonzero),
+    /// in total of the arenas sharing retained (if any).
+    /// Chunks of at least a huge page are mapped to huge pages if huge_pages
+    /// (falls back to malloc), smaller chunks are allocated by malloc.
+    /// Chunks are mapped and bound to the NUMA node of the starting thread if
+    /// nodes is nonzero (requires HAVE_NUMA, otherwise mapped but unbound).
+    /// Initial chunk multiple is learned from detached blocks if adaptive,
+    /// with multiple as the initial value (learned is at least one).
+    block_arena(size_t multiple, size_t retain=zero, bool huge_pages=false,
+        size_t nodes=zero, bool adaptive=false,
+        const chunk_pool::total_ptr& retained={}) NOEXCEPT;
     block_arena(block_arena&& other) NOEXCEPT;
     virtual ~block_arena() NOEXCEPT;
 
@@ -46,7 +60,61 @@ public:
     /// Release all chunks chained to the address.
     void release(void* address) NOEXCEPT override;
 
+    /// Released chunk pool, nullptr if not retaining (thread safe).
+    const chunk_pool* pool() const NOEXCEPT;
+
+    /// Bytes mapped to the NUMA node by this arena (thread safe).
+    size_t mapped(size_t node) const NOEXCEPT;
+
+    /// Number of bindable NUMA nodes, zero if single node or unavailable.
+    static size_t numa_nodes() NOEXCEPT;
+
+    /// Current initial chunk multiple of wire size (thread safe).
+    double learned_multiple() const NOEXCEPT;
+
+    /// Number of blocks started and chunks chained beyond the first chunk of
+    /// a block (thread safe).
+    size_t blocks() const NOEXCEPT;
+    size_t chained() const NOEXCEPT;
+
+    /// Bytes of detached blocks not yet released (thread safe).
+    size_t in_flight() const NOEXCEPT;
+
+    /// Alignment padding bytes of detached blocks (thread safe).
+    size_t padding() const NOEXCEPT;
+
+    /// Largest detached block allocation (thread safe).
+    size_t largest() const NOEXCEPT;
+
+    /// Number of blocks detached and released (thread safe).
+    size_t detached() const NOEXCEPT;
+    size_t released() const NOEXCEPT;
+
 protected:
+    /// Pooled chunks are prefixed with their size, preserving max alignment.
+    static constexpr size_t prefix_size = alignof(std::max_align_t);
+    static_assert(prefix_size >= sizeof(size_t));
+
+    /// Mapped chunks are multiples of the (2MB) huge page size.
+    static constexpr size_t huge_page_size = 2u * 1024u * 1024u;
+
+    /// Round up to huge page size multiple.
+    static constexpr size_t to_huge_page(size_t value) NOEXCEPT
+    {
+        using namespace system;
+        BC_ASSERT_MSG(!is_add_overflow(value, sub1(huge_page_size)),
+            "overflow");
+        return (value + sub1(huge_page_size)) & ~sub1(huge_page_size);
+    }
+
+    /// Learned multiple is fixed point, in sixteenths of wire size.
+    static constexpr size_t ratio_scale = 16;
+
+    /// Learned multiple is this percentile of the ratio window.
+    static constexpr size_t ratio_percentile = 95;
+    static constexpr size_t ratio_window = 128;
+    typedef std::array<size_t, ratio_window> ratios;
+
     /// Determine alignment offset.
     static constexpr size_t to_aligned(size_t value, size_t align) NOEXCEPT
     {
@@ -61,6 +129,9 @@ protected:
     /// Malloc throws if memory is not allocated.
     virtual INLINE ALLOCATOR void* malloc_(size_t bytes) THROWS
     {
+        if (is_mapped())
+            return map_pages(bytes);
+
         BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
         return std::malloc(bytes);
         BC_POP_WARNING()
@@ -69,11 +140,74 @@ protected:
     /// Free does not throw, behavior is undefined if address is incorrect.
     virtual INLINE void free_(void* address) NOEXCEPT
     {
+        if (is_mapped())
+        {
+            unmap_pages(address);
+            return;
+        }
+
         BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
         std::free(address);
         BC_POP_WARNING()
     }
 
+    /// Chunks are mapped for huge pages and/or NUMA node binding.
+    INLINE bool is_mapped() const NOEXCEPT
+    {
+        return huge_pages_ || !node_bytes_.empty();
+    }
+
+    /// A chunk of bytes (with prefixes) is mapped to huge pages.
+    INLINE bool is_huge(size_t bytes) const NOEXCEPT
+    {
+        return huge_pages_ && bytes >= huge_page_size;
+    }
+
+    /// Map huge pages (explicit, then transparent) or regular pages, bind to
+    /// NUMA node if bound, falls back to malloc.
+    /// Mapped length is stored in a prefix, returns nullptr on failure.
+    void* map_pages(size_t bytes) NOEXCEPT;
+
+    /// Unmap (or free if fallback) an address obtained from map_pages.
+    void unmap_pages(void* address) NOEXCEPT;
+
+    /// Obtain a chunk of at least size bytes, from pool if retaining.
+    /// Size is rounded up to its pool size class when retaining, and to fill
+    /// its pages (including prefixes) when mapped to huge pages.
+    void* acquire(size_t& size) THROWS;
+
+    /// Return a chunk to the pool if retaining and within limit, else free.
+    void retire(void* address) NOEXCEPT;
+
+    /// Record the total to wire size ratio of a detached block and update
+    /// the learned multiple to the percentile of recent ratios.
+    void sample(size_t total) NOEXCEPT;
+
+    /// The terminal link of a detached block is its total, tagged as odd.
+    /// Chunks are maximally aligned, so chunk links are never odd.
+    static INLINE uint8_t* to_terminal(size_t total) NOEXCEPT
+    {
+        BC_ASSERT(!system::is_multiply_overflow(total, two));
+        BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+        return reinterpret_cast<uint8_t*>(
+            static_cast<uintptr_t>(system::add1(total * two)));
+        BC_POP_WARNING()
+    }
+
+    static INLINE bool is_terminal(const void* link) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+        return system::is_odd(reinterpret_cast<uintptr_t>(link));
+        BC_POP_WARNING()
+    }
+
+    static INLINE size_t from_terminal(const void* link) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+        return static_cast<size_t>(reinterpret_cast<uintptr_t>(link) / two);
+        BC_POP_WARNING()
+    }
+
     /// Link a memory chunk to the allocated stack.
     void push(size_t minimum=zero) THROWS;
 
@@ -108,12 +242,36 @@ protected:
     void do_deallocate(void* ptr, size_t bytes, size_t align) NOEXCEPT override;
     bool do_is_equal(const arena& other) const NOEXCEPT override;
 
+    // This is thread safe (pool is internally synchronized).
+    std::unique_ptr<chunk_pool> pool_;
+
     // These are unprotected, caller must guard.
     uint8_t* memory_map_;
     size_t multiple_;
     size_t offset_;
     size_t total_;
     size_t size_;
+    bool huge_pages_;
+    bool explicit_pages_;
+    int node_;
+    bool adaptive_;
+    size_t wire_size_;
+    size_t samples_;
+    size_t padded_;
+    ratios ratios_;
+
+    // These are thread safe, sized at construct.
+    std::vector<std::atomic_size_t> node_bytes_;
+
+    // These are thread safe.
+    std::atomic_size_t learned_;
+    std::atomic_size_t blocks_;
+    std::atomic_size_t chained_;
+    std::atomic_size_t in_flight_;
+    std::atomic_size_t padding_;
+    std::atomic_size_t largest_;
+    std::atomic_size_t detached_;
+    std::atomic_size_t released_;
 };
 
 } // namespace node
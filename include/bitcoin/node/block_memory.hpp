@@ -20,7 +20,11 @@
 #define LIBBITCOIN_NODE_BLOCK_MEMORY_HPP
 
 #include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <bitcoin/node/block_arena.hpp>
+#include <bitcoin/node/chunk_pool.hpp>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -34,18 +38,88 @@ public:
     DELETE_COPY_MOVE_DESTRUCT(block_memory);
 
     /// Per thread multiple of wire size for each linear allocation chunk.
-    /// Returns default_arena if multiple is zero or threads exceeded.
-    block_memory(size_t multiple, size_t threads) NOEXCEPT;
+    /// Returns default_arena if multiple or threads is zero. Threads arenas
+    /// are created up front, more are created on demand as threads require.
+    /// The arena of an exiting thread is returned for use by another thread.
+    /// Released chunks are retained for reuse up to retain bytes (in total
+    /// across arenas, including those created on demand).
+    /// Chunks are mapped to huge pages if huge_pages (falls back to malloc).
+    /// Chunks are bound to the NUMA node of the allocating thread if numa and
+    /// multiple NUMA nodes are detected (requires HAVE_NUMA, otherwise nop).
+    /// Each arena learns its multiple from observed blocks if adaptive.
+    block_memory(size_t multiple, size_t threads, size_t retain=zero,
+        bool huge_pages=false, bool numa=false, bool adaptive=false) NOEXCEPT;
 
     /// Each thread obtains an arena.
     arena* get_arena() NOEXCEPT override;
 
+    /// Number of arenas created, in use or available (thread safe).
+    size_t arenas() const NOEXCEPT;
+
+    /// Number of get_arena calls that returned default_arena (thread safe).
+    size_t fallbacks() const NOEXCEPT;
+
+    /// Released chunk pool totals across arenas (thread safe).
+    size_t retained() const NOEXCEPT;
+    size_t pool_hits() const NOEXCEPT;
+    size_t pool_misses() const NOEXCEPT;
+
+    /// Mean learned multiple of arenas that have started blocks, or the
+    /// configured multiple if none (thread safe).
+    double learned_multiple() const NOEXCEPT;
+
+    /// Ratio of chained chunks to started blocks across arenas (thread safe).
+    double chaining_rate() const NOEXCEPT;
+
+    /// Arena totals, largest is the maximum (thread safe).
+    size_t blocks() const NOEXCEPT;
+    size_t chained() const NOEXCEPT;
+    size_t in_flight() const NOEXCEPT;
+    size_t padding() const NOEXCEPT;
+    size_t largest() const NOEXCEPT;
+    size_t detached() const NOEXCEPT;
+    size_t released() const NOEXCEPT;
+
+    /// Number of bound NUMA nodes, zero if not binding (thread safe).
+    size_t nodes() const NOEXCEPT;
+
+    /// Bytes mapped to each bound NUMA node across arenas (thread safe).
+    std_vector<size_t> node_allocations() const NOEXCEPT;
+
 protected:
-    // This is thread safe.
-    std::atomic_size_t count_{ zero };
+    /// Arenas outlive threads, so thread exit requires weak reference.
+    struct registry
+    {
+        // These are protected by mutex.
+        std::deque<block_arena> arenas{};
+        std_vector<block_arena*> available{};
+        mutable std::mutex mutex{};
+    };
+
+    typedef std::shared_ptr<registry> registry_ptr;
+
+    /// Obtain an available arena or create one.
+    block_arena* obtain() NOEXCEPT;
 
-    // This is protected by constructor init and thread_local indexation.
-    std::vector<block_arena> arenas_{};
+    /// Sum a pool property across arenas.
+    template <typename Method>
+    size_t sum_pools(Method method) const NOEXCEPT;
+
+    /// Sum an arena property across arenas.
+    template <typename Method>
+    size_t sum_arenas(Method method) const NOEXCEPT;
+
+    // These are thread safe.
+    const uint64_t identity_;
+    const size_t multiple_;
+    const size_t limit_;
+    const bool huge_pages_;
+    const bool adaptive_;
+    const size_t nodes_;
+    const registry_ptr registry_;
+    const chunk_pool::total_ptr retained_;
+    std::atomic_size_t count_{ zero };
+    std::atomic_size_t fallbacks_{ zero };
 };
 
 } // namespace node
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_PREFETCH_HPP
+#define LIBBITCOIN_NODE_BLOCK_PREFETCH_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread SAFE read-ahead of blocks for validation.
+/// Links are pushed ahead of (or as) they are posted for validation and are
+/// dispatched for reading (next) while fewer than capacity are reserved or
+/// read. A reader begins a dispatched read unless it was taken first. A block
+/// is taken once by validation, waiting for a read in flight (hit), taking a
+/// read block (hit), or claiming a link not yet being read (miss), so that
+/// each block is read from the store once. A block read ahead but not posted
+/// may never be taken, so is evicted once validation passes its height.
+class BCN_API block_prefetch
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(block_prefetch);
+
+    /// Read ahead at most capacity blocks (zero disables).
+    block_prefetch(size_t capacity) NOEXCEPT;
+
+    /// Queue a link for reading (ignored if disabled, queued or reserved).
+    void push(header_t link, size_t height) NOEXCEPT;
+
+    /// Queue a link for reading as posted for validation (not evicted).
+    void post(header_t link, size_t height) NOEXCEPT;
+
+    /// Remove queued, reserved and read blocks not posted at or below height.
+    void evict(size_t height) NOEXCEPT;
+
+    /// Reserve the next queued link to read, false if none or at capacity.
+    bool next(header_t& out) NOEXCEPT;
+
+    /// Begin the read of a reserved link, false if taken (or cleared).
+    bool begin(header_t link) NOEXCEPT;
+
+    /// Retain the wire block of a begun read (empty drops reservation).
+    /// Ignored if the link was cleared while being read.
+    void put(header_t link, system::data_chunk&& data) NOEXCEPT;
+
+    /// Remove and return the wire block of link, waiting for a read in
+    /// flight, empty if not read (miss, and the link is not then read).
+    system::data_chunk take(header_t link) NOEXCEPT;
+
+    /// Remove all queued, reserved and read blocks (does not count).
+    void clear() NOEXCEPT;
+
+    /// Properties.
+    bool enabled() const NOEXCEPT;
+    size_t capacity() const NOEXCEPT;
+    size_t size() const NOEXCEPT;
+    size_t queued() const NOEXCEPT;
+    size_t hits() const NOEXCEPT;
+    size_t misses() const NOEXCEPT;
+
+    /// Percentage of takes that were hits (zero if none).
+    size_t hit_rate() const NOEXCEPT;
+
+private:
+    struct entry
+    {
+        size_t height{};
+        bool posted{};
+    };
+
+    struct slot
+    {
+        system::data_chunk data{};
+        bool reading{};
+        entry key{};
+    };
+
+    void enqueue(header_t link, const entry& key) NOEXCEPT;
+
+    // These are thread safe.
+    const size_t capacity_;
+    std::atomic_size_t hits_{};
+    std::atomic_size_t misses_{};
+
+    // These are protected by mutex.
+    // Queue entries not in queued_ were taken before dispatch (skipped).
+    std::deque<header_t> queue_{};
+    std::unordered_map<header_t, entry> queued_{};
+    std::unordered_map<header_t, slot> blocks_{};
+    std::condition_variable read_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
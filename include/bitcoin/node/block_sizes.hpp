@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_SIZES_HPP
+#define LIBBITCOIN_NODE_BLOCK_SIZES_HPP
+
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Estimated serialized (witness) block size by height, for sizing the
+/// download window in bytes. Interpolated from mainnet era averages, beyond
+/// which the last average is used. The estimates do not apply to other
+/// chains, for which the download window is not limited by bytes.
+class BCN_API block_sizes
+{
+public:
+    /// Estimated size in bytes of the block at height (nonzero).
+    static size_t estimate(size_t height) NOEXCEPT;
+
+    /// Number of blocks above start with estimated sizes summing to no more
+    /// than bytes, at least one (if limit is nonzero) and at most limit.
+    /// Bytes of max_uint64 is unlimited (limit is returned).
+    static size_t span(size_t start, uint64_t bytes, size_t limit) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
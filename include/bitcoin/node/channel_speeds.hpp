@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CHANNEL_SPEEDS_HPP
+#define LIBBITCOIN_NODE_CHANNEL_SPEEDS_HPP
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread UNSAFE channel speeds with incrementally maintained statistics.
+/// Mean and deviation are updated in constant time (Welford, with removal),
+/// and resynchronized periodically to bound floating point drift. Median is
+/// maintained in constant time by an iterator into the ordered speeds. The
+/// median absolute deviation (robust) is linear, computed only on the first
+/// call following a change.
+class BCN_API channel_speeds
+{
+public:
+    DELETE_COPY_MOVE(channel_speeds);
+    ~channel_speeds() = default;
+
+    channel_speeds() NOEXCEPT;
+
+    /// Set (insert or replace) the speed of the channel.
+    void set(object_key channel, double speed) NOEXCEPT;
+
+    /// Remove the speed of the channel, false if not found.
+    bool erase(object_key channel) NOEXCEPT;
+
+    /// Get the speed of the channel, false if not found.
+    bool get(double& out, object_key channel) const NOEXCEPT;
+
+    /// Get the channel with the lowest speed, false if empty.
+    bool slowest(object_key& out) const NOEXCEPT;
+
+    /// Number of channels.
+    size_t size() const NOEXCEPT;
+
+    /// Sum of speeds.
+    double sum() const NOEXCEPT;
+
+    /// Mean speed (zero if empty).
+    double mean() const NOEXCEPT;
+
+    /// Sample standard deviation of speeds (zero if fewer than two).
+    double deviation() const NOEXCEPT;
+
+    /// Median speed (zero if empty).
+    double median() const NOEXCEPT;
+
+    /// Median absolute deviation, scaled to estimate standard deviation.
+    double spread() const NOEXCEPT;
+
+protected:
+    typedef std::pair<double, object_key> element;
+    typedef std::set<element> ordered;
+
+    /// Consistency constant of MAD for normally distributed speeds.
+    static constexpr double mad_scale = 1.4826;
+
+    /// Welford sums are recomputed after this many removals.
+    static constexpr size_t resync_interval = 1024;
+
+    void insert(const element& value) NOEXCEPT;
+    void extract(const element& value) NOEXCEPT;
+    void add(double speed) NOEXCEPT;
+    void remove(double speed) NOEXCEPT;
+    void resync() NOEXCEPT;
+
+    // These are not thread safe.
+    std::unordered_map<object_key, double> speeds_;
+    ordered ordered_;
+    ordered::const_iterator middle_;
+    double mean_;
+    double squares_;
+    size_t removals_;
+    mutable double spread_;
+    mutable bool spread_valid_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
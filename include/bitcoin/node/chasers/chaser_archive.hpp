@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CHASERS_CHASER_ARCHIVE_HPP
+#define LIBBITCOIN_NODE_CHASERS_CHASER_ARCHIVE_HPP
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+class full_node;
+
+/// Check and archive downloaded blocks off of the channel strand (write-
+/// behind), so that large block checks and disk stalls do not block reads.
+/// Bounded by protocols, which stop requesting work at a pending limit.
+class BCN_API chaser_archive
+  : public chaser
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(chaser_archive);
+
+    chaser_archive(full_node& node) NOEXCEPT;
+
+    code start() NOEXCEPT override;
+    void stopping(const code& ec) NOEXCEPT override;
+    void stop() NOEXCEPT override;
+
+    /// Check and store the block, notify chase::checked, invoke handler.
+    /// Executed on the archive threadpool, or inline if configured without.
+    /// A block already pending (endgame copy) completes, without a write,
+    /// with the result of the pending write.
+    virtual void write(const system::chain::block::cptr& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass, network::result_handler&& handler) NOEXCEPT;
+
+protected:
+    /// Post a method in base or derived class in parallel (use PARALLEL).
+    template <class Derived, typename Method, typename... Args>
+    inline auto parallel(Method&& method, Args&&... args) NOEXCEPT
+    {
+        return boost::asio::post(archive_threadpool_.service(),
+            BIND_THIS(method, args));
+    }
+
+    virtual void do_write(const system::chain::block::cptr& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass,
+        const network::steady_clock::time_point& start,
+        const network::result_handler& handler) NOEXCEPT;
+    virtual code write_block(const system::chain::block& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass) NOEXCEPT;
+    virtual code check(const system::chain::block& block,
+        const system::chain::context& ctx, bool bypass) const NOEXCEPT;
+
+private:
+    // This is thread safe (work runs on its own threads).
+    network::threadpool archive_threadpool_;
+
+    typedef std::vector<network::result_handler> handlers;
+
+    bool begin(const database::header_link& link,
+        network::result_handler& handler) NOEXCEPT;
+    handlers end(const database::header_link& link) NOEXCEPT;
+
+    // These are thread safe.
+    std::atomic<size_t> pending_{};
+    const bool inline_;
+
+    // Blocks pending archival with queued copies, protected by mutex.
+    std::unordered_map<header_t, handlers> writing_{};
+    std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -19,10 +19,12 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 
-#include <deque>
+#include <atomic>
 #include <unordered_map>
+#include <bitcoin/node/channel_speeds.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/height_bitmap.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -42,24 +44,40 @@ public:
     /// Move half of map into returned map.
     static map_ptr split(const map_ptr& map) NOEXCEPT;
 
+    /// Move upper (highest height) half of map into returned map.
+    static map_ptr split_upper(const map_ptr& map) NOEXCEPT;
+
     chaser_check(full_node& node) NOEXCEPT;
 
     /// Initialize chaser state.
     code start() NOEXCEPT override;
     void stopping(const code& ec) NOEXCEPT override;
 
-    /// Interface for protocols to provide performance data.
-    virtual void update(object_key channel, uint64_t speed,
+    /// Interface for protocols to provide performance data. Excess implies
+    /// that the channel is outbound and outbound channels exceed the target.
+    virtual void update(object_key channel, uint64_t speed, bool excess,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Outbound connection target, adapted to download rate (thread safe).
+    virtual size_t outbound_target() const NOEXCEPT;
+
+    /// An end-game copy of the block at height may be outstanding.
+    virtual bool is_endgame(size_t height) const NOEXCEPT;
+
+    /// Interface for protocols to provide persisted (prior run) performance.
+    virtual void prior(object_key channel, uint64_t speed) NOEXCEPT;
+
     /// Interface for protocols to obtain/return pending download identifiers.
     /// Identifiers not downloaded must be returned or chain will remain gapped.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    virtual void get_hashes(object_key channel,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
 protected:
     virtual void handle_purged(const code& ec) NOEXCEPT;
+    virtual void handle_endgame_timer(const code& ec) NOEXCEPT;
+    virtual void handle_outbound_timer(const code& ec) NOEXCEPT;
     virtual bool handle_event(const code& ec, chase event_,
         event_value value) NOEXCEPT;
 
@@ -68,24 +86,44 @@ protected:
     virtual void do_checked(height_t height) NOEXCEPT;
     virtual void do_advanced(height_t height) NOEXCEPT;
     virtual void do_headers(height_t branch_point) NOEXCEPT;
+    virtual void do_organized(height_t branch_point) NOEXCEPT;
     virtual void do_regressed(height_t branch_point) NOEXCEPT;
     virtual void do_handle_purged(const code& ec) NOEXCEPT;
-    virtual void do_get_hashes(const map_handler& handler) NOEXCEPT;
+    virtual void do_get_hashes(object_key channel,
+        const map_handler& handler) NOEXCEPT;
     virtual void do_put_hashes(const map_ptr& map,
         const network::result_handler& handler) NOEXCEPT;
 
+    /// end-game (redundant requests for blocks blocking validation)
+    virtual void do_endgame() NOEXCEPT;
+    virtual void do_stopping(const code& ec) NOEXCEPT;
+
+    /// adaptive outbound connection target
+    virtual void do_outbound() NOEXCEPT;
+
     /// channel performance
     virtual void do_starved(object_t self) NOEXCEPT;
-    virtual void do_update(object_key channel, uint64_t speed,
+    virtual void do_update(object_key channel, uint64_t speed, bool excess,
         const network::result_handler& handler) NOEXCEPT;
+    virtual void do_prior(object_key channel, uint64_t speed) NOEXCEPT;
 
 private:
     static constexpr size_t minimum_for_standard_deviation = 4;
-    typedef std::unordered_map<object_key, double> speeds;
-    typedef std::deque<map_ptr> maps;
-
-    map_ptr get_map() NOEXCEPT;
+    static constexpr size_t endgame_limit = 16;
+    static constexpr double outbound_improvement = 1.05;
+
+    map_ptr get_map(object_key channel) NOEXCEPT;
+    bool is_frontier(height_t bottom) const NOEXCEPT;
+    bool is_fast(object_key channel) const NOEXCEPT;
+    double get_center() const NOEXCEPT;
+    size_t get_batch_size(object_key channel) const NOEXCEPT;
+    map_ptr get_redundant(object_key channel) NOEXCEPT;
+    void filter_returned(database::associations& map) NOEXCEPT;
+    void set_advanced(height_t height) NOEXCEPT;
     size_t set_unassociated() NOEXCEPT;
+    size_t scan_unassociated(size_t stop) NOEXCEPT;
+    map_ptr get_unissued(size_t count, bool highest) NOEXCEPT;
+    void reset_unissued(size_t branch_point) NOEXCEPT;
     size_t get_inventory_size() const NOEXCEPT;
     bool set_map(const map_ptr& map) NOEXCEPT;
 
@@ -95,20 +133,54 @@ private:
 
     // These are thread safe.
     const float allowed_deviation_;
+    const bool robust_deviation_;
     const size_t maximum_concurrency_;
+    const uint64_t maximum_window_bytes_;
     const size_t maximum_height_;
     const size_t connections_;
     const size_t step_;
+    const network::steady_clock::duration endgame_period_;
+    const network::steady_clock::duration sample_period_;
+    const size_t minimum_outbound_;
+    const size_t maximum_outbound_;
+    std::atomic<size_t> outbound_;
+    std::atomic<size_t> endgame_top_;
 
     // These are protected by strand.
     size_t inventory_{};
     size_t requested_{};
     size_t advanced_{};
+    size_t scanned_{};
     job::ptr job_{};
 
-    // TODO: optimize, default bucket count is around 8.
-    speeds speeds_{};
-    maps maps_{};
+    // Unassociated candidates scanned (at or below scanned_) but not issued,
+    // including returned work. Cut into per channel batches upon issue.
+    database::associations unissued_{};
+
+    // Associated candidate heights (unset implies unknown, not unassociated).
+    height_bitmap associated_{};
+
+    // Lowest height issued work and the channel to which it was issued.
+    height_t frontier_{};
+    object_key blocker_{};
+
+    // Copy of frontier work as issued, and redundant work pending/issued.
+    network::deadline::ptr endgame_timer_{};
+    network::steady_clock::time_point advanced_at_{};
+    map_ptr blocking_{};
+    map_ptr endgame_{};
+    database::associations redundant_{};
+    bool ending_{};
+
+    // Outbound target is grown while aggregate rate improves by the factor.
+    network::deadline::ptr outbound_timer_{};
+    double outbound_rate_{};
+
+    // Channel speeds with incrementally maintained statistics.
+    channel_speeds speeds_{};
+
+    // Persisted speeds of channels not yet measured (initial work sizing).
+    std::unordered_map<object_key, double> priors_{};
 };
 
 } // namespace node
@@ -20,6 +20,8 @@
 #define LIBBITCOIN_NODE_CHASERS_CHASER_VALIDATE_HPP
 
 #include <atomic>
+#include <memory>
+#include <bitcoin/node/block_prefetch.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -60,15 +62,25 @@ protected:
     virtual void do_bumped(height_t height) NOEXCEPT;
     virtual void do_bump(height_t height) NOEXCEPT;
 
-    virtual void post_block(const database::header_link& link,
+    virtual void post_block(const database::header_link& link, size_t height,
         bool bypass) NOEXCEPT;
+    virtual bool is_postable(const database::header_link& link,
+        size_t height) const NOEXCEPT;
     virtual void validate_block(const database::header_link& link,
         bool bypass) NOEXCEPT;
-    virtual code validate(bool bypass, const system::chain::block& block,
+    virtual system::chain::block::cptr get_block(
+        const database::header_link& link) NOEXCEPT;
+    virtual void prefetch_above(height_t gap) NOEXCEPT;
+    virtual void do_prefetch() NOEXCEPT;
+    virtual void prefetch_block(const database::header_link& link) NOEXCEPT;
+    virtual code validate(bool bypass,
+        const system::chain::block::cptr& block,
         const database::header_link& link,
         const system::chain::context& ctx) NOEXCEPT;
     virtual code populate(bool bypass, const system::chain::block& block,
         const system::chain::context& ctx) NOEXCEPT;
+    virtual code connect(const system::chain::block::cptr& block,
+        const system::chain::context& ctx) NOEXCEPT;
     virtual void complete_block(const code& ec,
         const database::header_link& link, size_t height,
         bool bypassed) NOEXCEPT;
@@ -78,15 +90,31 @@ protected:
     bool stranded() const NOEXCEPT override;
 
 private:
-    // This is protected by strand.
+    struct connection;
+    typedef std::shared_ptr<connection> connection_ptr;
+
+    size_t idle_threads(const system::chain::block& block) const NOEXCEPT;
+    static void connect_batches(const system::chain::block::cptr& block,
+        const system::chain::context& ctx, const connection_ptr& state,
+        size_t batch) NOEXCEPT;
+
+    // These are protected by strand.
     network::threadpool validation_threadpool_;
+    network::threadpool prefetch_threadpool_;
+
+    // Gap height above which blocks were last read ahead.
+    height_t prefetched_{};
 
     // These are thread safe.
     std::atomic<size_t> backlog_{};
+    block_prefetch prefetch_;
     network::asio::strand validation_strand_;
+    network::memory& memory_;
     const uint32_t subsidy_interval_;
     const uint64_t initial_subsidy_;
     const size_t maximum_backlog_;
+    const size_t threads_;
+    const size_t parallel_connect_;
     const bool node_witness_;
     const bool defer_;
     const bool filter_;
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CHUNK_POOL_HPP
+#define LIBBITCOIN_NODE_CHUNK_POOL_HPP
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread SAFE size-classed free list of released arena chunks.
+/// The pool does not allocate or free chunks, it only retains addresses.
+/// Chunks are retained by exact size, which must be a size class.
+class BCN_API chunk_pool
+{
+public:
+    DELETE_COPY_MOVE(chunk_pool);
+
+    /// Bytes retained across pools that share a limit.
+    typedef std::shared_ptr<std::atomic_size_t> total_ptr;
+
+    /// Retain at most limit bytes of released chunks (zero retains none).
+    /// The limit applies to the total of all pools sharing total (if any).
+    chunk_pool(size_t limit, const total_ptr& total={}) NOEXCEPT;
+
+    /// Retained chunks must be drained by the owner before destruct.
+    ~chunk_pool() NOEXCEPT;
+
+    /// Round up to one of four size classes per power of two (<= 25% waste).
+    static constexpr size_t to_class(size_t bytes) NOEXCEPT
+    {
+        using namespace system;
+        if (bytes <= minimum_class)
+            return minimum_class;
+
+        const auto step = power2(floored_log2(bytes)) / classes_per_power;
+        return ceilinged_multiply(ceilinged_divide(bytes, step), step);
+    }
+
+    /// Obtain a retained chunk of the size, nullptr if none (miss).
+    void* pop(size_t size) NOEXCEPT;
+
+    /// Retain a chunk of the size, false if it would exceed the limit (of the
+    /// shared total).
+    bool push(void* chunk, size_t size) NOEXCEPT;
+
+    /// Remove any one retained chunk, nullptr if none (does not count).
+    void* drain() NOEXCEPT;
+
+    /// Properties, retained is of this pool.
+    size_t limit() const NOEXCEPT;
+    size_t retained() const NOEXCEPT;
+    size_t hits() const NOEXCEPT;
+    size_t misses() const NOEXCEPT;
+
+private:
+    static constexpr size_t classes_per_power = 4;
+    static constexpr size_t minimum_class = 4096;
+    typedef std::map<size_t, std_vector<void*>> classes;
+
+    // These are thread safe.
+    const size_t limit_;
+    const total_ptr total_;
+    std::atomic_size_t retained_{};
+    std::atomic_size_t hits_{};
+    std::atomic_size_t misses_{};
+
+    // These are protected by mutex.
+    classes classes_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -61,7 +61,39 @@ enum events : uint8_t
     ancestry_msecs,       // getancestry timespan in milliseconds.
     filter_msecs,         // getfilter timespan in milliseconds.
     filterhashes_msecs,   // getfilterhashes timespan in milliseconds.
-    filterchecks_msecs    // getcfcheckpt timespan in milliseconds.
+    filterchecks_msecs,   // getcfcheckpt timespan in milliseconds.
+
+    /// Block memory (each sample period).
+    memory_in_flight,     // bytes of detached blocks not yet released.
+    memory_padding,       // alignment padding bytes in the period.
+    memory_largest,       // largest detached block allocation in bytes.
+    memory_detached,      // blocks detached in the period.
+    memory_released,      // blocks released in the period.
+    memory_chained,       // chunks chained beyond first in the period.
+
+    /// Download work.
+    download_batch,       // blocks issued to a channel (sized by its rate).
+    download_split,       // slow channel directed to split (measured count).
+    download_stall,       // all channels directed to split (no measurements).
+    download_sacrificed,  // blocks returned by a channel stopped to split.
+    download_rebalanced,  // blocks returned by a channel that continues.
+
+    /// Download end-game.
+    endgame_issued,       // blocks blocking validation requested redundantly.
+    endgame_redundant,    // redundant block copy discarded on arrival.
+    endgame_msecs,        // blocked validation timespan in milliseconds.
+
+    /// Adaptive outbound connections (each sample period).
+    outbound_target,      // outbound connection target.
+    outbound_rate,        // aggregate download rate in bytes per second.
+
+    /// Block archival (write-behind).
+    archive_queue,        // blocks pending archival (at handoff).
+    archive_msecs,        // handoff to archival completion in milliseconds.
+
+    /// Validation read-ahead (each validated block).
+    prefetch_hit_rate,    // percentage of validation reads found read ahead.
+    prefetch_wait_usecs   // validation blocked on store read in microseconds.
 };
 
 } // namespace node
@@ -19,10 +19,13 @@
 #ifndef LIBBITCOIN_NODE_FULL_NODE_HPP
 #define LIBBITCOIN_NODE_FULL_NODE_HPP
 
+#include <deque>
+#include <mutex>
 #include <bitcoin/node/block_memory.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/peer_history.hpp>
 #include <bitcoin/node/sessions/sessions.hpp>
 
 namespace libbitcoin {
@@ -77,10 +80,16 @@ public:
         organize_handler&& handler) NOEXCEPT;
 
     /// Manage download queue.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    virtual void get_hashes(object_key channel,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         result_handler&& handler) NOEXCEPT;
 
+    /// Check and archive a downloaded block (write-behind).
+    virtual void write_block(const system::chain::block::cptr& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass, result_handler&& handler) NOEXCEPT;
+
     /// Events.
     /// -----------------------------------------------------------------------
 
@@ -153,11 +162,31 @@ public:
 
     /// Handle performance, base returns false (implied terminate).
     virtual void performance(object_key channel, uint64_t speed,
-        result_handler&& handler) NOEXCEPT;
+        bool inbound, result_handler&& handler) NOEXCEPT;
+
+    /// Provide persisted performance of a starting channel (work sizing).
+    virtual void prior_performance(object_key channel,
+        uint64_t speed) NOEXCEPT;
+
+    /// Get the persisted peer performance history.
+    virtual peer_history& get_history() NOEXCEPT;
+
+    /// Admit an outbound connection attempt while established and pending
+    /// outbound connections are below the (download adaptive) target.
+    virtual bool admit_outbound() NOEXCEPT;
+
+    /// An admitted outbound connection attempt has connected.
+    virtual void outbound_connected() NOEXCEPT;
+
+    /// An end-game copy of the block at height may be outstanding.
+    virtual bool is_endgame(size_t height) const NOEXCEPT;
 
     /// Get the memory resource.
     virtual network::memory& get_memory() NOEXCEPT;
 
+    /// Get the memory controller (for telemetry).
+    virtual const memory_controller& get_memory_controller() const NOEXCEPT;
+
 protected:
     /// Session attachments.
     /// -----------------------------------------------------------------------
@@ -179,16 +208,28 @@ private:
     void do_notify(const code& ec, chase event_, event_value value) NOEXCEPT;
     void do_notify_one(object_key key, const code& ec, chase event_,
         event_value value) NOEXCEPT;
+    size_t outbound_channel_count() const NOEXCEPT;
+    void handle_memory_timer(const code& ec) NOEXCEPT;
+    void report_memory() NOEXCEPT;
+    std::filesystem::path history_file() const NOEXCEPT;
+    void load_history() NOEXCEPT;
+    void save_history() NOEXCEPT;
 
     // These are thread safe.
     const configuration& config_;
     memory_controller memory_;
+    peer_history history_;
     query& query_;
 
+    // Admitted outbound connection attempts, protected by mutex.
+    std::deque<network::steady_clock::time_point> pending_{};
+    std::mutex pending_mutex_{};
+
     // These are protected by strand.
     chaser_block chaser_block_;
     chaser_header chaser_header_;
     chaser_check chaser_check_;
+    chaser_archive chaser_archive_;
     chaser_validate chaser_validate_;
     chaser_confirm chaser_confirm_;
     chaser_transaction chaser_transaction_;
@@ -196,6 +237,13 @@ private:
     chaser_snapshot chaser_snapshot_;
     chaser_storage chaser_storage_;
     event_subscriber event_subscriber_{};
+    network::deadline::ptr memory_timer_{};
+
+    // Prior sample of cumulative memory telemetry, protected by strand.
+    size_t padding_{};
+    size_t detached_{};
+    size_t released_{};
+    size_t chained_{};
 };
 
 } // namespace node
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_HEIGHT_BITMAP_HPP
+#define LIBBITCOIN_NODE_HEIGHT_BITMAP_HPP
+
+#include <deque>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread UNSAFE sliding bitmap of heights.
+/// Heights below the floor (trimmed) or never set are unset.
+class BCN_API height_bitmap
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(height_bitmap);
+
+    height_bitmap() NOEXCEPT;
+
+    /// True if the height is set.
+    bool is_set(size_t height) const NOEXCEPT;
+
+    /// First unset height at or above height (word at a time).
+    size_t next_unset(size_t height) const NOEXCEPT;
+
+    /// Set the height.
+    void set(size_t height) NOEXCEPT;
+
+    /// Set all heights in [first, last].
+    void set(size_t first, size_t last) NOEXCEPT;
+
+    /// Unset the height.
+    void reset(size_t height) NOEXCEPT;
+
+    /// Unset all heights above height.
+    void reset_above(size_t height) NOEXCEPT;
+
+    /// Discard whole words below height (heights below floor are unset).
+    void trim(size_t height) NOEXCEPT;
+
+    /// Unset all heights.
+    void clear() NOEXCEPT;
+
+    /// Number of heights set.
+    size_t count() const NOEXCEPT;
+
+protected:
+    static constexpr size_t word_bits = 64;
+    static constexpr uint64_t full = ~uint64_t{ 0 };
+
+    static constexpr size_t to_floor(size_t height) NOEXCEPT
+    {
+        return height - (height % word_bits);
+    }
+
+    /// Extend words to include height.
+    void extend(size_t height) NOEXCEPT;
+
+    // These are not thread safe.
+    size_t floor_;
+    std::deque<uint64_t> words_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PEER_HISTORY_HPP
+#define LIBBITCOIN_NODE_PEER_HISTORY_HPP
+
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe per peer address download performance history.
+/// Rate (bytes/sec) and latency (milliseconds) are exponentially smoothed.
+/// Persisted as one line per peer ("address rate latency") so that fast peers
+/// are known and preferred immediately following a restart. At capacity the
+/// least recently updated peer is evicted (persisted in that order).
+class BCN_API peer_history
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(peer_history);
+
+    struct record
+    {
+        uint64_t rate;
+        uint32_t latency;
+    };
+
+    /// Retain at most capacity peers (zero retains none).
+    peer_history(size_t capacity) NOEXCEPT;
+
+    /// Replace history with file contents, false if not loaded.
+    bool load(const std::filesystem::path& file) NOEXCEPT;
+
+    /// Write history to file (replaced), false if not saved.
+    bool save(const std::filesystem::path& file) const NOEXCEPT;
+
+    /// Merge a rate (bytes/sec) sample for the peer, zero is ignored.
+    void set_rate(const std::string& peer, uint64_t rate) NOEXCEPT;
+
+    /// Merge a latency (milliseconds) sample for the peer.
+    void set_latency(const std::string& peer, uint32_t latency) NOEXCEPT;
+
+    /// Get the history of the peer, false if not found.
+    bool get(record& out, const std::string& peer) const NOEXCEPT;
+
+    /// Get the smoothed rate of the peer, zero if not found.
+    uint64_t rate(const std::string& peer) const NOEXCEPT;
+
+    /// Queue the fastest count peers (by rate, then latency) for preference.
+    void prefer(size_t count) NOEXCEPT;
+
+    /// Pop the next preferred peer, false if none remain.
+    bool next(std::string& out) NOEXCEPT;
+
+    /// Number of peers.
+    size_t size() const NOEXCEPT;
+
+protected:
+    /// Weight of the prior value in the smoothed value.
+    static constexpr uint64_t total_weight = 4;
+    static constexpr uint64_t prior_weight = 3;
+
+    typedef std::list<std::string> ages;
+
+    struct entry
+    {
+        record value;
+        ages::iterator age;
+    };
+
+    typedef std::unordered_map<std::string, entry> records;
+
+    static uint64_t smooth(uint64_t prior, uint64_t sample) NOEXCEPT;
+    record* touch(const std::string& peer) NOEXCEPT;
+    void insert(const std::string& peer, const record& value) NOEXCEPT;
+
+private:
+    // This is thread safe.
+    const size_t capacity_;
+
+    // These are protected by mutex.
+    records records_;
+    ages ages_;
+    std::deque<std::string> preferred_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
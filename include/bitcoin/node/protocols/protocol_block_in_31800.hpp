@@ -19,6 +19,8 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_31800_HPP
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_31800_HPP
 
+#include <algorithm>
+#include <deque>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/protocols/protocol_performer.hpp>
@@ -41,7 +43,9 @@ public:
             session->system_settings().top_checkpoint().height()),
         block_type_(session->network_settings().witness_node() ?
             type_id::witness_block : type_id::block),
-        map_(chaser_check::empty_map()),
+        depth_(std::max<size_t>(session->node_settings().pipeline_depth, one)),
+        rebalance_(session->node_settings().rebalance_work),
+        archive_backlog_(session->node_settings().archive_backlog),
         network::tracker<protocol_block_in_31800>(session->log)
     {
     }
@@ -74,11 +78,24 @@ protected:
     virtual bool handle_receive_block(const code& ec,
         const network::messages::peer::block::cptr& message) NOEXCEPT;
 
-private:
-    code check(const system::chain::block& block,
-        const system::chain::context& ctx, bool bypass) const NOEXCEPT;
+    /// Handle block archival completion (write-behind).
+    /// The job is retained until archival of each of its blocks completes.
+    virtual void handle_write_block(const code& ec,
+        const system::chain::block::cptr& block, const map_ptr& work,
+        const job::ptr& job) NOEXCEPT;
+    virtual void do_write_block(const code& ec,
+        const system::chain::block::cptr& block, const map_ptr& work,
+        const job::ptr& job) NOEXCEPT;
 
+private:
     void send_get_data(const map_ptr& map, const job::ptr& job) NOEXCEPT;
+    void get_work() NOEXCEPT;
+    void complete(const map_ptr& map,
+        const system::hash_digest& hash) NOEXCEPT;
+    bool is_draining() const NOEXCEPT;
+    size_t outstanding() const NOEXCEPT;
+    void restore_all() NOEXCEPT;
+    void rebalance() NOEXCEPT;
     network::messages::peer::get_data create_get_data(
         const database::associations& map) const NOEXCEPT;
 
@@ -91,11 +108,23 @@ private:
     // These are thread safe.
     const size_t top_checkpoint_height_;
     const type_id block_type_;
+    const size_t depth_;
+    const bool rebalance_;
+    const size_t archive_backlog_;
 
     // These are protected by strand.
-    map_ptr map_;
+    // Outstanding get_data batches, oldest first (at most depth_).
+    std::deque<map_ptr> maps_{};
+    size_t batch_{};
+    bool requesting_{};
+    bool exhausted_{};
+    bool announced_{};
+    size_t archiving_{};
     job::ptr job_{};
 
+    // Time of get_data sent from idle, until first requested block arrives.
+    network::steady_clock::time_point requested_at_{};
+
     std_vector<system::chain::block::cptr> blocks_{};
 };
 
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_PEER_HPP
 
 #include <memory>
+#include <string>
 #include <bitcoin/node/channels/channels.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/protocols/protocol.hpp>
@@ -71,6 +72,11 @@ protected:
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Check and archive a downloaded block (write-behind).
+    virtual void write_block(const system::chain::block::cptr& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass, network::result_handler&& handler) NOEXCEPT;
+
     /// Methods.
     /// -----------------------------------------------------------------------
 
@@ -78,6 +84,21 @@ protected:
     virtual void performance(uint64_t speed,
         network::result_handler&& handler) const NOEXCEPT;
 
+    /// Report persisted performance of the peer (work sizing).
+    virtual void prior_performance(uint64_t speed) const NOEXCEPT;
+
+    /// Get the persisted peer performance history.
+    virtual peer_history& get_history() const NOEXCEPT;
+
+    /// The peer is recorded in performance history (outbound only).
+    virtual bool is_history_recorded() const NOEXCEPT;
+
+    /// An end-game copy of the block at height may be outstanding.
+    virtual bool is_endgame(size_t height) const NOEXCEPT;
+
+    /// The peer address as keyed in performance history.
+    virtual std::string history_key() const NOEXCEPT;
+
     /// Suspend all existing and future network connections.
     /// A race condition could result in an unsuspended connection.
     virtual code fault(const code& ec) NOEXCEPT;
@@ -63,6 +63,7 @@ private:
 
     // These are protected by strand.
     uint64_t bytes_{ zero };
+    bool prior_{};
     network::steady_clock::time_point start_{};
     network::deadline::ptr performance_timer_;
 };
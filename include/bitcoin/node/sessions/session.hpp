@@ -21,6 +21,7 @@
 
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/peer_history.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -47,10 +48,16 @@ public:
         organize_handler&& handler) NOEXCEPT;
 
     /// Manage download queue.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    virtual void get_hashes(object_key channel,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Check and archive a downloaded block (write-behind).
+    virtual void write_block(const system::chain::block::cptr& block,
+        const database::header_link& link, const system::chain::context& ctx,
+        bool checked, bool bypass, network::result_handler&& handler) NOEXCEPT;
+
     /// Events.
     /// -----------------------------------------------------------------------
 
@@ -75,10 +82,33 @@ public:
     /// Methods.
     /// -----------------------------------------------------------------------
 
+    /// Channels of the session are inbound (base returns false).
+    virtual bool is_inbound() const NOEXCEPT;
+
     /// Handle performance, base returns false (implied terminate).
     virtual void performance(object_key channel, uint64_t speed,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Provide persisted performance of a starting channel (work sizing).
+    virtual void prior_performance(object_key channel,
+        uint64_t speed) NOEXCEPT;
+
+    /// Get the persisted peer performance history.
+    virtual peer_history& get_history() const NOEXCEPT;
+
+    /// Channel peers are recorded in history (outbound dialed addresses).
+    virtual bool is_history_recorded() const NOEXCEPT;
+
+    /// Admit an outbound connection attempt while established and pending
+    /// outbound connections are below the (download adaptive) target.
+    virtual bool admit_outbound() const NOEXCEPT;
+
+    /// An admitted outbound connection attempt has connected.
+    virtual void outbound_connected() const NOEXCEPT;
+
+    /// An end-game copy of the block at height may be outstanding.
+    virtual bool is_endgame(size_t height) const NOEXCEPT;
+
     /// Get the memory resource.
     virtual network::memory& get_memory() const NOEXCEPT;
 
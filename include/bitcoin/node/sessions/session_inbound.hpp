@@ -33,6 +33,9 @@ public:
     using base = session_peer<network::session_inbound>;
     using base::base;
 
+    /// Channels are inbound.
+    bool is_inbound() const NOEXCEPT override;
+
 protected:
     bool enabled() const NOEXCEPT override;
 };
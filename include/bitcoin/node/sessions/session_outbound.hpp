@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_SESSIONS_SESSION_OUTBOUND_HPP
 #define LIBBITCOIN_NODE_SESSIONS_SESSION_OUTBOUND_HPP
 
+#include <string>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/sessions/session_peer.hpp>
 
@@ -32,6 +33,21 @@ public:
     typedef std::shared_ptr<session_outbound> ptr;
     using base = session_peer<network::session_outbound>;
     using base::base;
+
+    /// Dialed peers are recorded in history for preference.
+    bool is_history_recorded() const NOEXCEPT override;
+
+protected:
+    /// Deferred above the outbound target, and historically fastest peers
+    /// are taken before the address pool.
+    void take(network::address_item_handler&& handler) const NOEXCEPT override;
+
+    /// A connected attempt is no longer pending admission.
+    channel_ptr create_channel(const socket_ptr& socket) NOEXCEPT override;
+
+private:
+    static network::address_item_cptr to_address(
+        const std::string& peer) NOEXCEPT;
 };
 
 } // namespace node
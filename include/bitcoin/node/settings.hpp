@@ -39,19 +39,35 @@ public:
     bool thread_priority;
     bool memory_priority;
     bool allow_overlapped;
+    bool allocation_adaptive;
+    bool allocation_huge_pages;
+    bool allocation_numa;
     bool defer_validation;
     bool defer_confirmation;
+    bool robust_deviation;
+    bool rebalance_work;
     float allowed_deviation;
     float minimum_fee_rate;
     float minimum_bump_rate;
     uint16_t announcement_cache;
     uint16_t allocation_multiple;
+    uint16_t pipeline_depth;
+    uint16_t history_preferred;
+    uint16_t current_outbound;
+    uint16_t archive_backlog;
+    uint16_t prefetch_blocks;
+    uint64_t allocation_retain_bytes;
+    uint64_t maximum_window_bytes;
     ////uint64_t snapshot_bytes;
     ////uint32_t snapshot_valid;
     ////uint32_t snapshot_confirm;
     uint32_t maximum_height;
     uint32_t maximum_concurrency;
+    uint32_t history_capacity;
+    uint32_t parallel_connect;
+    uint32_t archive_threads;
     uint16_t sample_period_seconds;
+    uint16_t endgame_seconds;
     uint32_t currency_window_minutes;
     uint32_t threads;
 
@@ -59,7 +75,9 @@ public:
     virtual size_t threads_() const NOEXCEPT;
     virtual size_t maximum_height_() const NOEXCEPT;
     virtual size_t maximum_concurrency_() const NOEXCEPT;
+    virtual uint64_t maximum_window_bytes_() const NOEXCEPT;
     virtual network::steady_clock::duration sample_period() const NOEXCEPT;
+    virtual network::steady_clock::duration endgame_period() const NOEXCEPT;
     virtual network::wall_clock::duration currency_window() const NOEXCEPT;
     virtual network::processing_priority thread_priority_() const NOEXCEPT;
     virtual network::memory_priority memory_priority_() const NOEXCEPT;
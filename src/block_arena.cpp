@@ -19,6 +19,17 @@
 #include <bitcoin/node/block_arena.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#if !defined(HAVE_MSC)
+    #include <sys/mman.h>
+#endif
+#if defined(HAVE_NUMA)
+    #include <numa.h>
+    #include <sched.h>
+#endif
+#include <bitcoin/node/chunk_pool.hpp>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -29,21 +40,83 @@ using namespace system;
 // construct/destruct/assign
 // ----------------------------------------------------------------------------
 
-block_arena::block_arena(size_t multiple) NOEXCEPT
-  : memory_map_{ nullptr },
+// Page mapping is not implemented for Windows (huge pages need privilege).
+constexpr bool mapping_supported() NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    return false;
+#else
+    return true;
+#endif
+}
+
+// NUMA node of the calling thread, negative if unknown.
+int current_numa_node() NOEXCEPT
+{
+#if defined(HAVE_NUMA)
+    const auto cpu = ::sched_getcpu();
+    return cpu < 0 ? -1 : ::numa_node_of_cpu(cpu);
+#else
+    return -1;
+#endif
+}
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+block_arena::block_arena(size_t multiple, size_t retain, bool huge_pages,
+    size_t nodes, bool adaptive, const chunk_pool::total_ptr& retained) NOEXCEPT
+  : pool_{ is_zero(retain) ? nullptr :
+        std::make_unique<chunk_pool>(retain, retained) },
+    memory_map_{ nullptr },
     multiple_{ multiple },
     offset_{ zero },
     total_{ zero },
-    size_{ zero }
+    size_{ zero },
+    huge_pages_{ huge_pages && mapping_supported() },
+    explicit_pages_{ huge_pages_ },
+    node_{ -1 },
+    adaptive_{ adaptive },
+    wire_size_{ zero },
+    samples_{ zero },
+    padded_{ zero },
+    ratios_{},
+    node_bytes_(mapping_supported() ? nodes : zero),
+    learned_{ ceilinged_multiply(multiple, ratio_scale) },
+    blocks_{ zero },
+    chained_{ zero },
+    in_flight_{ zero },
+    padding_{ zero },
+    largest_{ zero },
+    detached_{ zero },
+    released_{ zero }
 {
 }
+BC_POP_WARNING()
 
 block_arena::block_arena(block_arena&& other) NOEXCEPT
-  : memory_map_{ other.memory_map_ },
+  : pool_{ std::move(other.pool_) },
+    memory_map_{ other.memory_map_ },
     multiple_{ other.multiple_ },
     offset_{ other.offset_ },
     total_{ other.total_ },
-    size_{ other.size_ }
+    size_{ other.size_ },
+    huge_pages_{ other.huge_pages_ },
+    explicit_pages_{ other.explicit_pages_ },
+    node_{ other.node_ },
+    adaptive_{ other.adaptive_ },
+    wire_size_{ other.wire_size_ },
+    samples_{ other.samples_ },
+    padded_{ other.padded_ },
+    ratios_{ other.ratios_ },
+    node_bytes_{ std::move(other.node_bytes_) },
+    learned_{ other.learned_.load(std::memory_order_relaxed) },
+    blocks_{ other.blocks_.load(std::memory_order_relaxed) },
+    chained_{ other.chained_.load(std::memory_order_relaxed) },
+    in_flight_{ other.in_flight_.load(std::memory_order_relaxed) },
+    padding_{ other.padding_.load(std::memory_order_relaxed) },
+    largest_{ other.largest_.load(std::memory_order_relaxed) },
+    detached_{ other.detached_.load(std::memory_order_relaxed) },
+    released_{ other.released_.load(std::memory_order_relaxed) }
 {
     // Prevents free(memory_map_) as responsibility is passed to this object.
     other.memory_map_ = nullptr;
@@ -51,15 +124,51 @@ block_arena::block_arena(block_arena&& other) NOEXCEPT
 
 block_arena::~block_arena() NOEXCEPT
 {
+    if (!pool_)
+        return;
+
+    // Retained chunks are owned by the arena, the pool only holds addresses.
+    while (const auto chunk = pool_->drain())
+        free_(chunk);
 }
 
 block_arena& block_arena::operator=(block_arena&& other) NOEXCEPT
 {
+    if (pool_)
+        while (const auto chunk = pool_->drain())
+            free_(chunk);
+
+    pool_ = std::move(other.pool_);
     memory_map_ = other.memory_map_;
     multiple_ = other.multiple_;
     offset_ = other.offset_;
     total_ = other.total_;
     size_ = other.size_;
+    huge_pages_ = other.huge_pages_;
+    explicit_pages_ = other.explicit_pages_;
+    node_ = other.node_;
+    adaptive_ = other.adaptive_;
+    wire_size_ = other.wire_size_;
+    samples_ = other.samples_;
+    padded_ = other.padded_;
+    ratios_ = other.ratios_;
+    node_bytes_ = std::move(other.node_bytes_);
+    learned_.store(other.learned_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    blocks_.store(other.blocks_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    chained_.store(other.chained_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    in_flight_.store(other.in_flight_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    padding_.store(other.padding_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    largest_.store(other.largest_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    detached_.store(other.detached_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    released_.store(other.released_.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
 
     // Prevents free(memory_map_) as responsibility is passed to this object.
     other.memory_map_ = nullptr;
@@ -71,10 +180,29 @@ block_arena& block_arena::operator=(block_arena&& other) NOEXCEPT
 
 void* block_arena::start(size_t wire_size) THROWS
 {
-    if (is_multiply_overflow(wire_size, multiple_))
-        throw allocation_exception{};
+    if (adaptive_)
+    {
+        const auto learned = learned_.load(std::memory_order_relaxed);
+        if (is_multiply_overflow(wire_size, learned))
+            throw allocation_exception{};
+
+        size_ = ceilinged_divide(wire_size * learned, ratio_scale);
+    }
+    else
+    {
+        if (is_multiply_overflow(wire_size, multiple_))
+            throw allocation_exception{};
 
-    size_ = wire_size * multiple_;
+        size_ = wire_size * multiple_;
+    }
+
+    // Bind chunks of this block to the node of the (deserializing) thread.
+    if (!node_bytes_.empty())
+        node_ = current_numa_node();
+
+    wire_size_ = wire_size;
+    padded_ = zero;
+    blocks_.fetch_add(one, std::memory_order_relaxed);
     memory_map_ = nullptr;
     offset_ = zero;
     total_ = zero;
@@ -84,31 +212,151 @@ void* block_arena::start(size_t wire_size) THROWS
 
 size_t block_arena::detach() NOEXCEPT
 {
+    const auto total = total_ + offset_;
+    if (!is_null(memory_map_))
+    {
+        if (adaptive_)
+            sample(total);
+
+        // Total is carried to release for in flight accounting.
+        set_link(to_terminal(total));
+        in_flight_.fetch_add(total, std::memory_order_relaxed);
+        padding_.fetch_add(padded_, std::memory_order_relaxed);
+        detached_.fetch_add(one, std::memory_order_relaxed);
+
+        // Only the leasing thread detaches, so there is no competing writer.
+        if (total > largest_.load(std::memory_order_relaxed))
+            largest_.store(total, std::memory_order_relaxed);
+    }
+
     memory_map_ = nullptr;
-    return total_ + offset_;
+    return total;
 }
 
+// Release may occur on any thread, as the block is destroyed.
 void block_arena::release(void* address) NOEXCEPT
 {
     while (!is_null(address))
     {
         const auto link = get_link(pointer_cast<uint8_t>(address));
-        free_(address);
+        retire(address);
+
+        // An undetached block is unaccounted, terminating in nullptr.
+        if (is_terminal(link))
+        {
+            in_flight_.fetch_sub(from_terminal(link),
+                std::memory_order_relaxed);
+            released_.fetch_add(one, std::memory_order_relaxed);
+            return;
+        }
+
         address = link;
     }
 }
 
+const chunk_pool* block_arena::pool() const NOEXCEPT
+{
+    return pool_.get();
+}
+
+size_t block_arena::mapped(size_t node) const NOEXCEPT
+{
+    return node < node_bytes_.size() ?
+        node_bytes_.at(node).load(std::memory_order_relaxed) : zero;
+}
+
+double block_arena::learned_multiple() const NOEXCEPT
+{
+    return static_cast<double>(learned_.load(std::memory_order_relaxed)) /
+        ratio_scale;
+}
+
+size_t block_arena::blocks() const NOEXCEPT
+{
+    return blocks_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::chained() const NOEXCEPT
+{
+    return chained_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::in_flight() const NOEXCEPT
+{
+    return in_flight_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::padding() const NOEXCEPT
+{
+    return padding_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::largest() const NOEXCEPT
+{
+    return largest_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::detached() const NOEXCEPT
+{
+    return detached_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::released() const NOEXCEPT
+{
+    return released_.load(std::memory_order_relaxed);
+}
+
+// static
+size_t block_arena::numa_nodes() NOEXCEPT
+{
+#if defined(HAVE_NUMA)
+    if (::numa_available() < 0)
+        return zero;
+
+    // Node identifiers may be sparse, so size by maximum node identifier.
+    const auto nodes = add1(::numa_max_node());
+    return nodes > 1 ? possible_narrow_sign_cast<size_t>(nodes) : zero;
+#else
+    return zero;
+#endif
+}
+
 // protected
 // ----------------------------------------------------------------------------
 
+void block_arena::sample(size_t total) NOEXCEPT
+{
+    if (is_zero(wire_size_))
+        return;
+
+    // Ratios are rounded up, so the learned multiple errs toward one chunk.
+    ratios_.at(samples_++ % ratio_window) = ceilinged_divide(
+        ceilinged_multiply(total, ratio_scale), wire_size_);
+
+    // Selection over a small window is cheap relative to deserialization.
+    auto window = ratios_;
+    const auto count = std::min(samples_, ratio_window);
+    const auto end = std::next(window.begin(), count);
+    const auto nth = std::next(window.begin(),
+        (sub1(count) * ratio_percentile) / 100u);
+
+    // Deserialized blocks exceed their wire size, so never learn below one.
+    std::nth_element(window.begin(), nth, end);
+    learned_.store(std::max(*nth, ratio_scale), std::memory_order_relaxed);
+}
+
 void block_arena::push(size_t minimum) THROWS
 {
+    // Chunks beyond the first of a block indicate an undersized multiple.
+    if (!is_null(memory_map_))
+        chained_.fetch_add(one, std::memory_order_relaxed);
+
     static constexpr size_t link_size = sizeof(void*);
 
     // Ensure next allocation accomodates link plus current request.
     BC_ASSERT(!is_add_overflow(minimum, link_size));
     size_ = std::max(size_, minimum + link_size);
-    const auto map = pointer_cast<uint8_t>(malloc_(size_));
+    const auto map = pointer_cast<uint8_t>(acquire(size_));
 
     if (is_null(map))
         throw allocation_exception{};
@@ -123,6 +371,175 @@ void block_arena::push(size_t minimum) THROWS
     offset_ = link_size;
 }
 
+void* block_arena::map_pages(size_t bytes) NOEXCEPT
+{
+    BC_ASSERT(!is_add_overflow(bytes, prefix_size));
+    const auto huge = is_huge(bytes + prefix_size);
+    const auto length = huge ? to_huge_page(bytes + prefix_size) :
+        bytes + prefix_size;
+
+    // A small chunk is only mapped for NUMA binding, as a mapping costs more
+    // than malloc (malloc fallback).
+    const auto map = huge || !node_bytes_.empty();
+    uint8_t* base{};
+
+#if !defined(HAVE_MSC)
+    // Explicit huge pages require a reserved pool, disable on first failure.
+    #if defined(MAP_HUGETLB)
+    if (huge && explicit_pages_)
+    {
+        const auto pages = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (pages == MAP_FAILED)
+            explicit_pages_ = false;
+        else
+            base = pointer_cast<uint8_t>(pages);
+    }
+    #endif
+
+    // Transparent huge pages are advisory, failure to advise is benign.
+    if (map && is_null(base))
+    {
+        const auto pages = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (pages != MAP_FAILED)
+        {
+            #if defined(MADV_HUGEPAGE)
+            if (huge)
+                ::madvise(pages, length, MADV_HUGEPAGE);
+            #endif
+            base = pointer_cast<uint8_t>(pages);
+        }
+    }
+
+    // Binding precedes first touch, so pages are placed on the node.
+    // Binding is a preference, failure to bind is benign.
+    #if defined(HAVE_NUMA)
+    if (!is_null(base) && node_ >= 0 &&
+        to_unsigned(node_) < node_bytes_.size())
+    {
+        ::numa_tonode_memory(base, length, node_);
+        node_bytes_.at(to_unsigned(node_)).fetch_add(length,
+            std::memory_order_relaxed);
+    }
+    #endif
+#endif
+
+    // Zero length prefix indicates malloc fallback.
+    auto mapped = length;
+    if (is_null(base))
+    {
+        mapped = zero;
+        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
+        base = pointer_cast<uint8_t>(std::malloc(bytes + prefix_size));
+        BC_POP_WARNING()
+
+        if (is_null(base))
+            return nullptr;
+    }
+
+    BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+    reinterpret_cast<size_t&>(*base) = mapped;
+    BC_POP_WARNING()
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    return base + prefix_size;
+    BC_POP_WARNING()
+}
+
+void block_arena::unmap_pages(void* address) NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    const auto base = pointer_cast<uint8_t>(address) - prefix_size;
+    BC_POP_WARNING()
+
+    BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+    const auto mapped = reinterpret_cast<const size_t&>(*base);
+    BC_POP_WARNING()
+
+    if (is_zero(mapped))
+    {
+        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
+        std::free(base);
+        BC_POP_WARNING()
+        return;
+    }
+
+#if !defined(HAVE_MSC)
+    ::munmap(base, mapped);
+#endif
+}
+
+void* block_arena::acquire(size_t& size) THROWS
+{
+    // Pooled chunks carry a class prefix, mapped chunks a length prefix.
+    const auto prefix = pool_ ? prefix_size : zero;
+
+    // Pooled chunks are keyed by size class. A mapped length that is a class
+    // rounded to huge pages remains a class (classes of 8MB and above are
+    // page multiples, and 2/4/6/8MB are classes), so it keys mapped chunks.
+    // Size is rounded to use all mapped bytes. Only a chunk of a class at or
+    // above the huge page size is mapped to huge pages, so smaller classes
+    // (below 2MB) never share a key with mapped chunks.
+    const auto overhead = prefix + prefix_size;
+    BC_ASSERT(!is_add_overflow(size, overhead));
+    const auto whole = chunk_pool::to_class(size + overhead);
+    auto key = size;
+    if (is_huge(whole))
+    {
+        key = to_huge_page(whole);
+        size = key - overhead;
+    }
+    else if (pool_)
+    {
+        key = size = chunk_pool::to_class(size);
+    }
+
+    if (!pool_)
+        return malloc_(size);
+
+    auto base = pointer_cast<uint8_t>(pool_->pop(key));
+
+    if (is_null(base))
+    {
+        BC_ASSERT(!is_add_overflow(size, prefix_size));
+        base = pointer_cast<uint8_t>(malloc_(size + prefix_size));
+        if (is_null(base))
+            return nullptr;
+    }
+
+    // The chunk class is stored in the prefix for retirement.
+    BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+    reinterpret_cast<size_t&>(*base) = key;
+    BC_POP_WARNING()
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    return base + prefix_size;
+    BC_POP_WARNING()
+}
+
+void block_arena::retire(void* address) NOEXCEPT
+{
+    if (!pool_)
+    {
+        free_(address);
+        return;
+    }
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    const auto base = pointer_cast<uint8_t>(address) - prefix_size;
+    BC_POP_WARNING()
+
+    BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+    const auto key = reinterpret_cast<const size_t&>(*base);
+    BC_POP_WARNING()
+
+    if (!pool_->push(base, key))
+        free_(base);
+}
+
 // protected interface
 // ----------------------------------------------------------------------------
 
@@ -142,6 +559,7 @@ void* block_arena::do_allocate(size_t bytes, size_t align) THROWS
     }
     else
     {
+        padded_ += padding;
         offset_ += allocation;
 
         BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
@@ -18,7 +18,12 @@
  */
 #include <bitcoin/node/block_memory.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <bitcoin/node/chunk_pool.hpp>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -26,20 +31,238 @@ namespace node {
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
-block_memory::block_memory(size_t multiple, size_t threads) NOEXCEPT
+// Distinguishes instances in thread-local leases (addresses may be reused).
+static std::atomic<uint64_t> instances{ zero };
+
+block_memory::block_memory(size_t multiple, size_t threads, size_t retain,
+    bool huge_pages, bool numa, bool adaptive) NOEXCEPT
+  : identity_{ instances.fetch_add(one, std::memory_order_relaxed) },
+    multiple_{ is_zero(threads) ? zero : multiple },
+    limit_{ is_zero(threads) ? zero : retain },
+    huge_pages_{ huge_pages },
+    adaptive_{ adaptive },
+    nodes_{ numa && is_nonzero(multiple_) ? block_arena::numa_nodes() : zero },
+    registry_{ std::make_shared<registry>() },
+    retained_{ std::make_shared<std::atomic_size_t>() }
 {
-    if (is_nonzero(multiple))
+    if (is_zero(multiple_))
+        return;
+
+    // Chunks are released to the arena that allocated them.
+    // Expected thread count is preallocated, first created is leased first.
+    for (auto index = zero; index < threads; ++index)
+        registry_->arenas.emplace_back(multiple_, limit_, huge_pages_, nodes_,
+            adaptive_, retained_);
+
+    for (auto it = registry_->arenas.rbegin(); it != registry_->arenas.rend();
+        ++it)
+        registry_->available.push_back(&(*it));
+}
+
+arena* block_memory::get_arena() NOEXCEPT
+{
+    if (is_zero(multiple_))
     {
-        arenas_.reserve(threads);
-        for (auto index = zero; index < threads; ++index)
-            arenas_.emplace_back(multiple);
+        fallbacks_.fetch_add(one, std::memory_order_relaxed);
+        return default_arena::get();
     }
+
+    // An arena is leased to a thread until the thread exits.
+    struct leased_arena
+    {
+        uint64_t identity;
+        std::weak_ptr<registry> owner;
+        block_arena* arena;
+    };
+
+    // Returns each leased arena to its registry (if any) upon thread exit.
+    struct leases
+      : public std::vector<leased_arena>
+    {
+        ~leases() NOEXCEPT
+        {
+            // Thread exit after block_memory destruct finds owner expired.
+            for (const auto& item: *this)
+            {
+                if (const auto owner = item.owner.lock())
+                {
+                    std::lock_guard lock(owner->mutex);
+                    owner->available.push_back(item.arena);
+                }
+            }
+        }
+    };
+
+    thread_local leases leased{};
+
+    // Instances are few, so linear search (and pruning) is sufficient.
+    std::erase_if(leased, [](const leased_arena& item) NOEXCEPT
+    {
+        return item.owner.expired();
+    });
+
+    for (const auto& item: leased)
+        if (item.identity == identity_)
+            return item.arena;
+
+    count_.fetch_add(one, std::memory_order_relaxed);
+    const auto arena = obtain();
+    leased.push_back({ identity_, registry_, arena });
+    return arena;
 }
 
-arena* block_memory::get_arena() NOEXCEPT
+block_arena* block_memory::obtain() NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    auto& available = registry_->available;
+
+    if (!available.empty())
+    {
+        const auto arena = available.back();
+        available.pop_back();
+        return arena;
+    }
+
+    // Deque growth preserves the addresses of leased arenas.
+    return &registry_->arenas.emplace_back(multiple_, limit_, huge_pages_,
+        nodes_, adaptive_, retained_);
+}
+
+size_t block_memory::arenas() const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    return registry_->arenas.size();
+}
+
+size_t block_memory::fallbacks() const NOEXCEPT
+{
+    return fallbacks_.load(std::memory_order_relaxed);
+}
+
+// Arenas are never removed from the registry and pools are thread safe.
+template <typename Method>
+size_t block_memory::sum_pools(Method method) const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    return std::accumulate(registry_->arenas.begin(), registry_->arenas.end(),
+        zero, [&](size_t total, const block_arena& arena) NOEXCEPT
+        {
+            const auto pool = arena.pool();
+            return is_null(pool) ? total : total + (pool->*method)();
+        });
+}
+
+template <typename Method>
+size_t block_memory::sum_arenas(Method method) const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    return std::accumulate(registry_->arenas.begin(), registry_->arenas.end(),
+        zero, [&](size_t total, const block_arena& arena) NOEXCEPT
+        {
+            return total + (arena.*method)();
+        });
+}
+
+size_t block_memory::retained() const NOEXCEPT
+{
+    return sum_pools(&chunk_pool::retained);
+}
+
+size_t block_memory::pool_hits() const NOEXCEPT
+{
+    return sum_pools(&chunk_pool::hits);
+}
+
+size_t block_memory::pool_misses() const NOEXCEPT
 {
-    thread_local auto thread = count_.fetch_add(one, std::memory_order_relaxed);
-    return thread < arenas_.size() ? &arenas_.at(thread) : default_arena::get();
+    return sum_pools(&chunk_pool::misses);
+}
+
+double block_memory::learned_multiple() const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    auto learned = 0.0;
+    auto count = zero;
+    for (const auto& arena: registry_->arenas)
+    {
+        if (is_nonzero(arena.blocks()))
+        {
+            learned += arena.learned_multiple();
+            ++count;
+        }
+    }
+
+    return is_zero(count) ? static_cast<double>(multiple_) : learned / count;
+}
+
+double block_memory::chaining_rate() const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    auto started = zero;
+    auto chains = zero;
+    for (const auto& arena: registry_->arenas)
+    {
+        started += arena.blocks();
+        chains += arena.chained();
+    }
+
+    return is_zero(started) ? 0.0 : static_cast<double>(chains) / started;
+}
+
+size_t block_memory::blocks() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::blocks);
+}
+
+size_t block_memory::chained() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::chained);
+}
+
+size_t block_memory::in_flight() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::in_flight);
+}
+
+size_t block_memory::padding() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::padding);
+}
+
+size_t block_memory::largest() const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    size_t largest{};
+    for (const auto& arena: registry_->arenas)
+        largest = std::max(largest, arena.largest());
+
+    return largest;
+}
+
+size_t block_memory::detached() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::detached);
+}
+
+size_t block_memory::released() const NOEXCEPT
+{
+    return sum_arenas(&block_arena::released);
+}
+
+size_t block_memory::nodes() const NOEXCEPT
+{
+    return nodes_;
+}
+
+std_vector<size_t> block_memory::node_allocations() const NOEXCEPT
+{
+    std::lock_guard lock(registry_->mutex);
+    std_vector<size_t> allocations(nodes_, zero);
+    for (auto node = zero; node < nodes_; ++node)
+        for (const auto& arena: registry_->arenas)
+            allocations.at(node) += arena.mapped(node);
+
+    return allocations;
 }
 
 BC_POP_WARNING()
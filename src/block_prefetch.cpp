@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_prefetch.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+block_prefetch::block_prefetch(size_t capacity) NOEXCEPT
+  : capacity_{ capacity }
+{
+}
+
+void block_prefetch::push(header_t link, size_t height) NOEXCEPT
+{
+    enqueue(link, { height, false });
+}
+
+void block_prefetch::post(header_t link, size_t height) NOEXCEPT
+{
+    enqueue(link, { height, true });
+}
+
+void block_prefetch::evict(size_t height) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        const auto evictable = [height](const entry& key) NOEXCEPT
+        {
+            return !key.posted && key.height <= height;
+        };
+
+        // Queue entries not in queued_ are skipped by next().
+        std::erase_if(queued_, [&](const auto& item) NOEXCEPT
+        {
+            return evictable(item.second);
+        });
+
+        // A read in flight is dropped by put().
+        std::erase_if(blocks_, [&](const auto& item) NOEXCEPT
+        {
+            return evictable(item.second.key);
+        });
+    }
+
+    read_.notify_all();
+}
+
+bool block_prefetch::next(header_t& out) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+
+    while (!queue_.empty() && blocks_.size() < capacity_)
+    {
+        const auto link = queue_.front();
+        queue_.pop_front();
+
+        // Validation has already taken (or evicted) this block.
+        const auto it = queued_.find(link);
+        if (it == queued_.end())
+            continue;
+
+        blocks_.emplace(link, slot{ {}, false, it->second });
+        queued_.erase(it);
+        out = link;
+        return true;
+    }
+
+    return false;
+}
+
+bool block_prefetch::begin(header_t link) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+
+    const auto it = blocks_.find(link);
+    if (it == blocks_.end())
+        return false;
+
+    it->second.reading = true;
+    return true;
+}
+
+void block_prefetch::put(header_t link, data_chunk&& data) NOEXCEPT
+{
+    {
+        std::lock_guard lock(mutex_);
+
+        const auto it = blocks_.find(link);
+        if (it == blocks_.end())
+            return;
+
+        if (data.empty())
+        {
+            blocks_.erase(it);
+        }
+        else
+        {
+            it->second.data = std::move(data);
+            it->second.reading = false;
+        }
+    }
+
+    read_.notify_all();
+}
+
+data_chunk block_prefetch::take(header_t link) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    // A read in flight completes (or is cleared) before the block is taken.
+    auto it = blocks_.find(link);
+    while (it != blocks_.end() && it->second.reading)
+    {
+        read_.wait(lock);
+        it = blocks_.find(link);
+    }
+
+    if (it == blocks_.end() || it->second.data.empty())
+    {
+        // Not read, so claim it from the queue or reservation (not read).
+        queued_.erase(link);
+        if (it != blocks_.end())
+            blocks_.erase(it);
+
+        misses_.fetch_add(one, std::memory_order_relaxed);
+        return {};
+    }
+
+    auto data = std::move(it->second.data);
+    blocks_.erase(it);
+    hits_.fetch_add(one, std::memory_order_relaxed);
+    return data;
+}
+
+void block_prefetch::clear() NOEXCEPT
+{
+    {
+        std::lock_guard lock(mutex_);
+        queue_.clear();
+        queued_.clear();
+        blocks_.clear();
+    }
+
+    read_.notify_all();
+}
+
+// private
+void block_prefetch::enqueue(header_t link, const entry& key) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard lock(mutex_);
+
+    // A posted block is not evicted, whether read, reserved or queued.
+    if (const auto it = blocks_.find(link); it != blocks_.end())
+    {
+        it->second.key.posted |= key.posted;
+        return;
+    }
+
+    const auto [it, inserted] = queued_.try_emplace(link, key);
+    if (!inserted)
+    {
+        it->second.posted |= key.posted;
+        return;
+    }
+
+    queue_.push_back(link);
+}
+
+bool block_prefetch::enabled() const NOEXCEPT
+{
+    return !is_zero(capacity_);
+}
+
+size_t block_prefetch::capacity() const NOEXCEPT
+{
+    return capacity_;
+}
+
+size_t block_prefetch::size() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return blocks_.size();
+}
+
+size_t block_prefetch::queued() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return queued_.size();
+}
+
+size_t block_prefetch::hits() const NOEXCEPT
+{
+    return hits_.load(std::memory_order_relaxed);
+}
+
+size_t block_prefetch::misses() const NOEXCEPT
+{
+    return misses_.load(std::memory_order_relaxed);
+}
+
+size_t block_prefetch::hit_rate() const NOEXCEPT
+{
+    const auto hit = hits();
+    const auto total = ceilinged_add(hit, misses());
+    return is_zero(total) ? zero : (hit * 100u) / total;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
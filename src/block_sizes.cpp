@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_sizes.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+// Approximate mainnet average block size (bytes) at height.
+constexpr std::array<std::pair<size_t, size_t>, 18> eras
+{
+    {
+        { 0, 250 },
+        { 100'000, 1'000 },
+        { 150'000, 20'000 },
+        { 200'000, 100'000 },
+        { 250'000, 150'000 },
+        { 300'000, 350'000 },
+        { 350'000, 450'000 },
+        { 400'000, 900'000 },
+        { 450'000, 1'000'000 },
+        { 500'000, 1'050'000 },
+        { 550'000, 900'000 },
+        { 600'000, 1'200'000 },
+        { 650'000, 1'300'000 },
+        { 700'000, 1'200'000 },
+        { 750'000, 1'400'000 },
+        { 800'000, 1'700'000 },
+        { 850'000, 1'700'000 },
+        { 900'000, 1'600'000 }
+    }
+};
+
+size_t block_sizes::estimate(size_t height) NOEXCEPT
+{
+    // First era above height (height is at or above the first era).
+    const auto next = std::upper_bound(eras.begin(), eras.end(), height,
+        [](size_t value, const auto& era) NOEXCEPT
+        {
+            return value < era.first;
+        });
+
+    if (next == eras.end())
+        return eras.back().second;
+
+    // Linear interpolation within the era.
+    const auto& [top, top_size] = *next;
+    const auto& [base, base_size] = *std::prev(next);
+    const auto offset = height - base;
+    const auto width = top - base;
+
+    if (top_size >= base_size)
+        return base_size + (top_size - base_size) * offset / width;
+
+    return base_size - (base_size - top_size) * offset / width;
+}
+
+// Sum of floor((a * i + b) / m) for i in [0, n), in O(log) (m is nonzero).
+static uint64_t floor_sum(uint64_t n, uint64_t m, uint64_t a,
+    uint64_t b) NOEXCEPT
+{
+    uint64_t sum{};
+    while (true)
+    {
+        if (a >= m)
+        {
+            sum += (n * sub1(n) / two) * (a / m);
+            a %= m;
+        }
+
+        if (b >= m)
+        {
+            sum += n * (b / m);
+            b %= m;
+        }
+
+        const auto maximum = a * n + b;
+        if (maximum < m)
+            break;
+
+        n = maximum / m;
+        b = maximum % m;
+        std::swap(m, a);
+    }
+
+    return sum;
+}
+
+// Sum of estimates of count heights from height, within the era ending at next
+// (exclusive). This is the closed form of the interpolation in estimate().
+static uint64_t era_sum(size_t height, size_t count,
+    decltype(eras)::const_iterator next) NOEXCEPT
+{
+    const auto& [top, top_size] = *next;
+    const auto& [base, base_size] = *std::prev(next);
+    const auto rising = top_size >= base_size;
+    const uint64_t delta = rising ? top_size - base_size : base_size - top_size;
+    const uint64_t offset = height - base;
+    const uint64_t width = top - base;
+    const auto steps = floor_sum(count, width, delta, delta * offset);
+    const auto flat = uint64_t{ count } * base_size;
+    return rising ? flat + steps : flat - steps;
+}
+
+// Heights are summed per era segment (and the last era is constant), so
+// this is logarithmic in the span within an era, not linear.
+size_t block_sizes::span(size_t start, uint64_t bytes, size_t limit) NOEXCEPT
+{
+    // Unlimited bytes (limit may also be unlimited).
+    if (bytes == max_uint64)
+        return limit;
+
+    size_t count{};
+    uint64_t total{};
+    while (count < limit)
+    {
+        const auto height = ceilinged_add(start, add1(count));
+        const auto remaining = limit - count;
+        const auto next = std::upper_bound(eras.begin(), eras.end(), height,
+            [](size_t value, const auto& era) NOEXCEPT
+            {
+                return value < era.first;
+            });
+
+        // Beyond the last era every block is the last average.
+        if (next == eras.end())
+        {
+            const auto fit = (bytes - total) / eras.back().second;
+            count += possible_narrow_cast<size_t>(
+                std::min<uint64_t>(fit, remaining));
+            break;
+        }
+
+        // The whole era segment fits, continue with the next.
+        const auto segment = std::min(next->first - height, remaining);
+        const auto sum = era_sum(height, segment, next);
+        if (sum <= bytes - total)
+        {
+            total += sum;
+            count += segment;
+            continue;
+        }
+
+        // Largest prefix of the segment that fits (at least one excluded).
+        size_t low{}, high{ segment };
+        while (add1(low) < high)
+        {
+            const auto middle = low + to_half(high - low);
+            if (era_sum(height, middle, next) <= bytes - total)
+                low = middle;
+            else
+                high = middle;
+        }
+
+        count += low;
+        break;
+    }
+
+    // The first block is always included (window is never empty).
+    return is_zero(limit) ? zero : std::max(count, one);
+}
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/channel_speeds.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+channel_speeds::channel_speeds() NOEXCEPT
+  : speeds_{}, ordered_{}, middle_{ ordered_.end() }, mean_{}, squares_{},
+    removals_{}, spread_{}, spread_valid_{}
+{
+}
+
+void channel_speeds::set(object_key channel, double speed) NOEXCEPT
+{
+    const auto it = speeds_.find(channel);
+    if (it != speeds_.end())
+    {
+        remove(it->second);
+        extract({ it->second, channel });
+        it->second = speed;
+    }
+    else
+    {
+        speeds_.emplace(channel, speed);
+    }
+
+    insert({ speed, channel });
+    add(speed);
+
+    if (it != speeds_.end() && is_zero(removals_ % resync_interval))
+        resync();
+}
+
+bool channel_speeds::erase(object_key channel) NOEXCEPT
+{
+    const auto it = speeds_.find(channel);
+    if (it == speeds_.end())
+        return false;
+
+    remove(it->second);
+    extract({ it->second, channel });
+    speeds_.erase(it);
+
+    if (speeds_.empty() || is_zero(removals_ % resync_interval))
+        resync();
+
+    return true;
+}
+
+bool channel_speeds::get(double& out, object_key channel) const NOEXCEPT
+{
+    const auto it = speeds_.find(channel);
+    if (it == speeds_.end())
+        return false;
+
+    out = it->second;
+    return true;
+}
+
+bool channel_speeds::slowest(object_key& out) const NOEXCEPT
+{
+    if (ordered_.empty())
+        return false;
+
+    out = ordered_.begin()->second;
+    return true;
+}
+
+size_t channel_speeds::size() const NOEXCEPT
+{
+    return speeds_.size();
+}
+
+double channel_speeds::sum() const NOEXCEPT
+{
+    return mean_ * speeds_.size();
+}
+
+double channel_speeds::mean() const NOEXCEPT
+{
+    return mean_;
+}
+
+double channel_speeds::deviation() const NOEXCEPT
+{
+    const auto count = speeds_.size();
+    return count < two ? 0.0 : std::sqrt(squares_ / sub1(count));
+}
+
+// middle_ is the upper median element (index count / 2).
+double channel_speeds::median() const NOEXCEPT
+{
+    const auto count = ordered_.size();
+    if (is_zero(count))
+        return 0.0;
+
+    if (is_odd(count))
+        return middle_->first;
+
+    return (std::prev(middle_)->first + middle_->first) / 2.0;
+}
+
+double channel_speeds::spread() const NOEXCEPT
+{
+    if (ordered_.empty())
+        return 0.0;
+
+    if (spread_valid_)
+        return spread_;
+
+    const auto center = median();
+    std_vector<double> deviations{};
+    deviations.reserve(ordered_.size());
+    for (const auto& value: ordered_)
+        deviations.push_back(std::abs(value.first - center));
+
+    // Upper median of deviations (sufficient for a threshold).
+    const auto middle = std::next(deviations.begin(),
+        to_half(deviations.size()));
+    std::nth_element(deviations.begin(), middle, deviations.end());
+    spread_ = mad_scale * *middle;
+    spread_valid_ = true;
+    return spread_;
+}
+
+// protected
+void channel_speeds::insert(const element& value) NOEXCEPT
+{
+    const auto count = ordered_.size();
+    const auto it = ordered_.insert(value).first;
+    spread_valid_ = false;
+
+    if (is_zero(count))
+    {
+        middle_ = it;
+        return;
+    }
+
+    // The median index (count / 2) advances only when count becomes even.
+    const auto before = value < *middle_;
+    if (before && is_even(count))
+        middle_ = std::prev(middle_);
+    else if (!before && is_odd(count))
+        middle_ = std::next(middle_);
+}
+
+// protected
+void channel_speeds::extract(const element& value) NOEXCEPT
+{
+    const auto count = ordered_.size();
+    const auto it = ordered_.find(value);
+    if (it == ordered_.end())
+        return;
+
+    spread_valid_ = false;
+
+    // The median index (count / 2) retreats only when count becomes odd.
+    if (it == middle_)
+        middle_ = is_even(count) ? std::prev(middle_) : std::next(middle_);
+    else if (value < *middle_ && is_odd(count))
+        middle_ = std::next(middle_);
+    else if (*middle_ < value && is_even(count))
+        middle_ = std::prev(middle_);
+
+    ordered_.erase(it);
+    if (ordered_.empty())
+        middle_ = ordered_.end();
+}
+
+// protected
+void channel_speeds::add(double speed) NOEXCEPT
+{
+    // Welford's update, speeds_ already includes the speed.
+    const auto delta = speed - mean_;
+    mean_ += delta / speeds_.size();
+    squares_ += delta * (speed - mean_);
+}
+
+// protected
+void channel_speeds::remove(double speed) NOEXCEPT
+{
+    // Welford's reverse update, speeds_ still includes the speed.
+    ++removals_;
+    const auto count = speeds_.size();
+    if (count <= one)
+    {
+        mean_ = 0.0;
+        squares_ = 0.0;
+        return;
+    }
+
+    const auto delta = speed - mean_;
+    mean_ -= delta / sub1(count);
+    squares_ = std::max(squares_ - delta * (speed - mean_), 0.0);
+}
+
+// protected
+void channel_speeds::resync() NOEXCEPT
+{
+    // Reverse updates accumulate rounding error, so sums are recomputed.
+    mean_ = 0.0;
+    squares_ = 0.0;
+    if (speeds_.empty())
+        return;
+
+    for (const auto& value: speeds_)
+        mean_ += value.second;
+
+    mean_ /= speeds_.size();
+    for (const auto& value: speeds_)
+        squares_ += std::pow(value.second - mean_, 2.0);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/chasers/chaser_archive.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/full_node.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+#define CLASS chaser_archive
+
+using namespace system;
+using namespace database;
+using namespace std::chrono;
+using namespace std::placeholders;
+
+// Shared pointers required for lifetime in handler parameters.
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Independent threadpool (without threads when writing inline).
+chaser_archive::chaser_archive(full_node& node) NOEXCEPT
+  : chaser(node),
+    archive_threadpool_(node.node_settings().archive_threads,
+        node.node_settings().thread_priority_()),
+    inline_(is_zero(node.node_settings().archive_threads))
+{
+}
+
+code chaser_archive::start() NOEXCEPT
+{
+    return error::success;
+}
+
+// write
+// ----------------------------------------------------------------------------
+
+void chaser_archive::write(const chain::block::cptr& block,
+    const header_link& link, const chain::context& ctx, bool checked,
+    bool bypass, network::result_handler&& handler) NOEXCEPT
+{
+    if (closed())
+    {
+        handler(network::error::service_stopped);
+        return;
+    }
+
+    // A copy of a block pending archival completes with the first write.
+    if (!begin(link, handler))
+    {
+        fire(events::endgame_redundant, ctx.height);
+        return;
+    }
+
+    const auto start = steady_clock::now();
+    const auto pending = add1(pending_.fetch_add(one,
+        std::memory_order_relaxed));
+    fire(events::archive_queue, pending);
+
+    if (inline_)
+    {
+        do_write(block, link, ctx, checked, bypass, start, handler);
+        return;
+    }
+
+    PARALLEL(do_write, block, link, ctx, checked, bypass, start,
+        std::move(handler));
+}
+
+// Unstranded (concurrent by block)
+// ----------------------------------------------------------------------------
+
+void chaser_archive::do_write(const chain::block::cptr& block,
+    const header_link& link, const chain::context& ctx, bool checked,
+    bool bypass, const steady_clock::time_point& start,
+    const network::result_handler& handler) NOEXCEPT
+{
+    const auto ec = closed() ? network::error::service_stopped :
+        write_block(*block, link, ctx, checked, bypass);
+
+    const auto copies = end(link);
+    pending_.fetch_sub(one, std::memory_order_relaxed);
+    const auto span = duration_cast<milliseconds>(steady_clock::now() - start);
+    fire(events::archive_msecs, sign_cast<uint64_t>(span.count()));
+
+    for (const auto& copy: copies)
+        copy(ec);
+
+    handler(ec);
+}
+
+// Pending links are tracked as an endgame copy of a block may arrive on
+// another channel before the first is associated. The handler of a copy is
+// queued (moved) and false is returned.
+bool chaser_archive::begin(const header_link& link,
+    network::result_handler& handler) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto [it, inserted] = writing_.try_emplace(link.value);
+    if (!inserted)
+        it->second.push_back(std::move(handler));
+
+    return inserted;
+}
+
+// Returns the handlers of copies queued behind the write.
+chaser_archive::handlers chaser_archive::end(const header_link& link) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto it = writing_.find(link.value);
+    if (it == writing_.end())
+        return {};
+
+    auto copies = std::move(it->second);
+    writing_.erase(it);
+    return copies;
+}
+
+// Tx commitments and malleation are checked under bypass. Invalidity is
+// only stored when a strong header has been stored, later to be found out
+// as invalid and not malleable. Stored invalidity prevents repeat
+// processing of the same invalid chain but is not necessary or desirable.
+code chaser_archive::write_block(const chain::block& block,
+    const header_link& link, const chain::context& ctx, bool checked,
+    bool bypass) NOEXCEPT
+{
+    auto& query = archive();
+    const auto height = ctx.height;
+
+    // Check block.
+    // ........................................................................
+
+    if (const auto ec = check(block, ctx, bypass))
+    {
+        // Malleated block is not stored as invalid (peer is dropped).
+        if (ec == system::error::invalid_transaction_commitment ||
+            ec == system::error::invalid_witness_commitment)
+            return ec;
+
+        if (!query.set_block_unconfirmable(link))
+            return fault(error::protocol1);
+
+        notify(error::success, chase::unchecked, link);
+        fire(events::block_unconfirmable, height);
+        return ec;
+    }
+
+    // Commit block.txs.
+    // ........................................................................
+
+    if (const auto ec = query.set_code(block, link, checked, bypass, height))
+    {
+        LOGF("Failure storing block [" << encode_hash(block.hash()) << ":"
+            << height << "] " << ec.message());
+        return fault(ec);
+    }
+
+    // Advance.
+    // ........................................................................
+
+    notify(error::success, chase::checked, height);
+    fire(events::block_archived, height);
+    return error::success;
+}
+
+// Identity is correct unless error::invalid_witness_commitment or
+// error::invalid_transaction_commitment is returned. Only identity is required
+// under bypass. Header state is checked by organize.
+code chaser_archive::check(const chain::block& block,
+    const chain::context& ctx, bool bypass) const NOEXCEPT
+{
+    code ec{};
+    if (bypass)
+    {
+        if (((ec = block.identify())) || ((ec = block.identify(ctx))))
+            return ec;
+    }
+    else
+    {
+        if (((ec = block.check())) || ((ec = block.check(ctx))))
+            return ec;
+    }
+
+    return error::success;
+}
+
+// Overrides due to independent thread pool
+// ----------------------------------------------------------------------------
+
+void chaser_archive::stopping(const code& ec) NOEXCEPT
+{
+    // Stop threadpool keep-alive, all work must self-terminate to affect join.
+    archive_threadpool_.stop();
+    chaser::stopping(ec);
+}
+
+void chaser_archive::stop() NOEXCEPT
+{
+    if (!archive_threadpool_.join())
+    {
+        BC_ASSERT_MSG(false, "failed to join threadpool");
+        std::abort();
+    }
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -19,9 +19,10 @@
 #include <bitcoin/node/chasers/chaser_check.hpp>
 
 #include <algorithm>
-#include <cmath>
+#include <chrono>
 #include <memory>
 #include <ratio>
+#include <bitcoin/node/block_sizes.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
@@ -35,6 +36,7 @@ using namespace system;
 using namespace system::chain;
 using namespace database;
 using namespace network;
+using namespace std::chrono;
 using namespace std::placeholders;
 
 // Shared pointers required for lifetime in handler parameters.
@@ -52,6 +54,23 @@ size_t get_target_connections(const network::settings& network) NOEXCEPT
     return is_zero(outgoing) ? network.inbound.connections : outgoing;
 }
 
+// Adaptation is disabled (zero) or bounded by the configured outbound.
+size_t get_minimum_outbound(const node::settings& node,
+    const network::settings& network) NOEXCEPT
+{
+    return std::min<size_t>(node.current_outbound,
+        network.outbound.connections);
+}
+
+// Block size estimates are of mainnet, so the byte limit is off elsewhere.
+uint64_t get_window_bytes(const node::settings& node,
+    const network::settings& network) NOEXCEPT
+{
+    constexpr uint32_t mainnet_identifier = 0xd9b4bef9;
+    return network.identifier == mainnet_identifier ?
+        node.maximum_window_bytes_() : max_uint64;
+}
+
 size_t get_step(size_t connections, size_t maximum_concurrency) NOEXCEPT
 {
     constexpr auto max = messages::peer::max_inventory;
@@ -62,10 +81,20 @@ size_t get_step(size_t connections, size_t maximum_concurrency) NOEXCEPT
 chaser_check::chaser_check(full_node& node) NOEXCEPT
   : chaser(node),
     allowed_deviation_(node.node_settings().allowed_deviation),
+    robust_deviation_(node.node_settings().robust_deviation),
     maximum_concurrency_(node.node_settings().maximum_concurrency_()),
+    maximum_window_bytes_(get_window_bytes(node.node_settings(),
+        node.network_settings())),
     maximum_height_(node.node_settings().maximum_height_()),
     connections_(get_target_connections(node.network_settings())),
-    step_(get_step(connections_, maximum_concurrency_))
+    step_(get_step(connections_, maximum_concurrency_)),
+    endgame_period_(node.node_settings().endgame_period()),
+    sample_period_(node.node_settings().sample_period()),
+    minimum_outbound_(get_minimum_outbound(node.node_settings(),
+        node.network_settings())),
+    maximum_outbound_(node.network_settings().outbound.connections),
+    outbound_(is_zero(minimum_outbound_) ? max_size_t : minimum_outbound_),
+    endgame_top_(zero)
 {
 }
 
@@ -85,6 +114,16 @@ map_ptr chaser_check::split(const map_ptr& map) NOEXCEPT
     return half;
 }
 
+// static
+map_ptr chaser_check::split_upper(const map_ptr& map) NOEXCEPT
+{
+    const auto half = empty_map();
+    auto& index = map->get<association::pos>();
+    const auto begin = std::prev(index.end(), to_half(map->size()));
+    half->merge(index, begin, index.end());
+    return half;
+}
+
 // start/stop
 // ----------------------------------------------------------------------------
 
@@ -92,10 +131,26 @@ code chaser_check::start() NOEXCEPT
 {
     start_tracking();
     set_position(archive().get_fork());
-    requested_ = advanced_ = position();
+    requested_ = advanced_ = scanned_ = position();
     const auto added = set_unassociated();
     LOGN("Fork point (" << requested_ << ") unassociated (" << added << ").");
 
+    // Construct is too early to create the unstarted timer.
+    advanced_at_ = steady_clock::now();
+    if (to_bool(endgame_period_.count()))
+    {
+        endgame_timer_ = std::make_shared<deadline>(log, strand(),
+            endgame_period_);
+        POST(handle_endgame_timer, error::success);
+    }
+
+    if (!is_zero(minimum_outbound_) && to_bool(sample_period_.count()))
+    {
+        outbound_timer_ = std::make_shared<deadline>(log, strand(),
+            sample_period_);
+        POST(handle_outbound_timer, error::success);
+    }
+
     SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
     return error::success;
 }
@@ -104,9 +159,26 @@ void chaser_check::stopping(const code& ec) NOEXCEPT
 {
     // Allow job completion as soon as all protocols are closed.
     stop_tracking();
+    POST(do_stopping, ec);
     chaser::stopping(ec);
 }
 
+void chaser_check::do_stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (endgame_timer_)
+    {
+        endgame_timer_->stop();
+        endgame_timer_.reset();
+    }
+
+    if (outbound_timer_)
+    {
+        outbound_timer_->stop();
+        outbound_timer_.reset();
+    }
+}
+
 bool chaser_check::handle_event(const code&, chase event_,
     event_value value) NOEXCEPT
 {
@@ -151,7 +223,7 @@ bool chaser_check::handle_event(const code&, chase event_,
         case chase::headers:
         {
             BC_ASSERT(std::holds_alternative<height_t>(value));
-            POST(do_headers, std::get<height_t>(value));
+            POST(do_organized, std::get<height_t>(value));
             break;
         }
         case chase::valid:
@@ -217,36 +289,235 @@ void chaser_check::do_starved(object_t self) NOEXCEPT
     BC_ASSERT(stranded());
 
     // Remove the starved channel to prevent self-selection.
-    if (speeds_.find(self) != speeds_.end())
-        speeds_.erase(self);
+    speeds_.erase(self);
 
-    // Find the slowest reporting channel.
-    const auto slowest = std::min_element(speeds_.begin(), speeds_.end(),
-        [](const auto& left, const auto& right) NOEXCEPT
-        {
-            return left.second < right.second;
-        });
-
-    // Direct the slowest channel to split work and stop.
-    if (slowest != speeds_.end())
+    // Direct the slowest reporting channel to split work and stop.
+    object_key slow{};
+    if (speeds_.slowest(slow))
     {
         // Erase entry so less likely to be claimed again before stopping.
-        const auto slow = slowest->first;
-        speeds_.erase(slowest);
+        speeds_.erase(slow);
 
         // Notify slow channel to split itself (in favor of 'self' channel).
         notify_one(slow, error::success, chase::split, self);
+        fire(events::download_split, speeds_.size());
         return;
     }
 
     // With no speeds recorded there may still be channels with work.
     notify(error::success, chase::stall, self);
+    fire(events::download_stall, zero);
+}
+
+// end-game
+// ----------------------------------------------------------------------------
+
+void chaser_check::handle_endgame_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !endgame_timer_ || ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Check chaser end-game timer fault, " << ec.message());
+        return;
+    }
+
+    do_endgame();
+    endgame_timer_->start(BIND(handle_endgame_timer, _1));
+}
+
+// When all work is issued and the channel holding the frontier has blocked
+// validation for the end-game period, its lowest outstanding blocks are made
+// available to one fast idle channel. The first copy to arrive is archived.
+void chaser_check::do_endgame() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || purging() || endgame_ || !blocking_ || !unissued_.empty() ||
+        is_zero(blocker_) || steady_clock::now() - advanced_at_ <
+        endgame_period_)
+        return;
+
+    const auto blocked = add1(position());
+    const auto map = empty_map();
+    std::for_each(blocking_->pos_begin(), blocking_->pos_end(),
+        [&](const association& item) NOEXCEPT
+        {
+            const auto height = item.context.height;
+            if (map->size() < endgame_limit && height >= blocked &&
+                !associated_.is_set(height) &&
+                redundant_.find(item.hash) == redundant_.end())
+                map->insert(item);
+        });
+
+    // The blocked height must be held by the blocking channel.
+    if (map->empty() || map->pos_begin()->context.height != blocked)
+        return;
+
+    LOGV("End-game work (" << map->size() << ") at (" << blocked
+        << ") held by channel [" << blocker_ << "].");
+
+    endgame_ = map;
+    notify(error::success, chase::download, map->size());
+}
+
+// Redundant work is issued only to a fast channel not holding the original.
+map_ptr chaser_check::get_redundant(object_key channel) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (!endgame_ || channel == blocker_ || !is_fast(channel))
+        return empty_map();
+
+    const auto map = endgame_;
+    endgame_.reset();
+    redundant_.insert(map->begin(), map->end());
+    ending_ = true;
+
+    // Copies may be outstanding at or below the top height ever issued.
+    auto top = endgame_top_.load(std::memory_order_relaxed);
+    for (const auto& item: *map)
+        top = std::max(top, item.context.height);
+
+    endgame_top_.store(top, std::memory_order_relaxed);
+
+    LOGV("End-game work (" << map->size() << ") to channel [" << channel
+        << "].");
+
+    fire(events::endgame_issued, map->size());
+    return map;
+}
+
+// Drop returned work that is archived (by either copy), above the cursor
+// (to be rescanned after reorganization), and the first return of redundant
+// work (as the other copy remains outstanding).
+void chaser_check::filter_returned(associations& map) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Returned work is reissued normally, so pending end-game is moot.
+    endgame_.reset();
+
+    for (auto it = map.begin(); it != map.end();)
+    {
+        const auto height = it->context.height;
+        const auto copy = redundant_.find(it->hash);
+        if (copy != redundant_.end())
+        {
+            redundant_.erase(copy);
+            it = map.erase(it);
+        }
+        else if (height <= position() || height > scanned_ ||
+            associated_.is_set(height))
+        {
+            it = map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void chaser_check::set_advanced(height_t height) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto now = steady_clock::now();
+
+    // Report the blocked timespan that was resolved under end-game.
+    if (ending_)
+    {
+        ending_ = false;
+        const auto span = duration_cast<milliseconds>(now - advanced_at_);
+        fire(events::endgame_msecs, sign_cast<uint64_t>(span.count()));
+    }
+
+    // Redundant work at or below position is archived.
+    for (auto it = redundant_.begin(); it != redundant_.end();)
+        it = it->context.height <= height ? redundant_.erase(it) :
+            std::next(it);
+
+    advanced_at_ = now;
+}
+
+// adaptive outbound connection target
+// ----------------------------------------------------------------------------
+
+size_t chaser_check::outbound_target() const NOEXCEPT
+{
+    return outbound_.load(std::memory_order_relaxed);
+}
+
+// The slower copy of a block may arrive after end-game has resolved, so
+// heights remain covered until a purge (which drops all outstanding work).
+bool chaser_check::is_endgame(size_t height) const NOEXCEPT
+{
+    return height <= endgame_top_.load(std::memory_order_relaxed);
+}
+
+void chaser_check::handle_outbound_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !outbound_timer_ ||
+        ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Check chaser outbound timer fault, " << ec.message());
+        return;
+    }
+
+    do_outbound();
+    outbound_timer_->start(BIND(handle_outbound_timer, _1));
+}
+
+// While downloading, the target grows by a step each period in which the
+// aggregate rate has improved on that of the last growth, provided that
+// validation is keeping up (backlog under half of the download window). Once
+// validation lags it shrinks by a step, and once current it is the minimum.
+void chaser_check::do_outbound() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto rate = speeds_.sum();
+    const auto step = std::max(maximum_outbound_ / 10u, one);
+    const auto backlog = floored_subtract(position(), advanced_);
+    const auto headroom = backlog < to_half(maximum_concurrency_);
+    const auto prior = outbound_target();
+    auto target = prior;
+
+    if (is_current(true))
+    {
+        target = minimum_outbound_;
+        outbound_rate_ = {};
+    }
+    else if (!headroom)
+    {
+        target = std::max(floored_subtract(target, step), minimum_outbound_);
+        outbound_rate_ = rate;
+    }
+    else if (rate > outbound_rate_ * outbound_improvement)
+    {
+        target = std::min(ceilinged_add(target, step), maximum_outbound_);
+        outbound_rate_ = rate;
+    }
+
+    outbound_.store(target, std::memory_order_relaxed);
+    fire(events::outbound_target, target);
+    fire(events::outbound_rate, to_integer<uint64_t>(rate));
+
+    if (target != prior)
+    {
+        LOGN("Outbound target (" << target << ") from (" << prior
+            << ") rate (" << to_integer<uint64_t>(rate) << ") backlog ("
+            << backlog << ").");
+    }
 }
 
 // update
 // ----------------------------------------------------------------------------
 
-void chaser_check::update(object_key channel, uint64_t speed,
+void chaser_check::update(object_key channel, uint64_t speed, bool excess,
     network::result_handler&& handler) NOEXCEPT
 {
     if (closed())
@@ -256,7 +527,24 @@ void chaser_check::update(object_key channel, uint64_t speed,
     }
 
     boost::asio::post(strand(),
-        BIND(do_update, channel, speed, handler));
+        BIND(do_update, channel, speed, excess, handler));
+}
+
+void chaser_check::prior(object_key channel, uint64_t speed) NOEXCEPT
+{
+    if (closed())
+        return;
+
+    boost::asio::post(strand(),
+        BIND(do_prior, channel, speed));
+}
+
+void chaser_check::do_prior(object_key channel, uint64_t speed) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Not factored into statistics, so cannot cause a channel to be dropped.
+    priors_[channel] = to_floating(speed);
 }
 
 std::string to_kilobits_per_second(double value) NOEXCEPT
@@ -267,10 +555,18 @@ std::string to_kilobits_per_second(double value) NOEXCEPT
 }
 
 void chaser_check::do_update(object_key channel, uint64_t speed,
-    const network::result_handler& handler) NOEXCEPT
+    bool excess, const network::result_handler& handler) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // A measured (or closed) channel no longer requires its prior speed.
+    priors_.erase(channel);
+
+    // Channel no longer holds work (exhausted, stalled or closed).
+    if (speed == max_uint64 || is_zero(speed))
+        if (channel == blocker_)
+            blocker_ = {};
+
     if (speed == max_uint64)
     {
         speeds_.erase(channel);
@@ -288,7 +584,7 @@ void chaser_check::do_update(object_key channel, uint64_t speed,
 
     // Integer to floating point.
     const auto fast = to_floating(speed);
-    speeds_[channel] = fast;
+    speeds_.set(channel, fast);
 
     // Three elements are required to measure deviation, don't drop below.
     const auto count = speeds_.size();
@@ -298,24 +594,27 @@ void chaser_check::do_update(object_key channel, uint64_t speed,
         return;
     }
 
-    double sum = 0.0;
-    double sum_squares = 0.0;
-    for (const auto& element : speeds_)
-    {
-        sum += element.second;
-        sum_squares += std::pow(element.second, two);
-    }
-
-    const auto mean = sum / count;
+    // Statistics are maintained incrementally. The robust center and spread
+    // (median/MAD) are not moved by a single fast (or slow) outlier.
+    const auto sum = speeds_.sum();
+    const auto mean = get_center();
     if (fast >= mean)
     {
         handler(error::success);
         return;
     }
 
-    const auto variance = (sum_squares - (sum * sum) / count) / sub1(count);
-    const auto sdev = std::sqrt(variance);
-    const auto slow = (mean - fast) > (allowed_deviation_ * sdev);
+    // A zero spread (MAD of mostly equal rates) implies no outliers.
+    const auto sdev = robust_deviation_ ? speeds_.spread() :
+        speeds_.deviation();
+    const auto deviant = sdev > 0.0 &&
+        (mean - fast) > (allowed_deviation_ * sdev);
+
+    // A below average channel holding the frontier is blocking validation.
+    const auto blocking = channel == blocker_ && frontier_ > position();
+
+    // Below average outbound channels are shed while above outbound target.
+    const auto slow = deviant || blocking || excess;
 
     // Only speed < mean channels are logged.
     LOGV("Below average channel (" << count << ") rate ("
@@ -340,6 +639,10 @@ void chaser_check::do_regressed(height_t branch_point) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // Candidates above the branch point are replaced, so are not indexed.
+    associated_.reset_above(branch_point);
+    reset_unissued(branch_point);
+
     // Inconsequential regression, work isn't there yet.
     if (branch_point >= position())
         return;
@@ -347,7 +650,12 @@ void chaser_check::do_regressed(height_t branch_point) NOEXCEPT
     // Update position, purge outstanding work, and wait on track completion.
     set_position(branch_point);
     stop_tracking();
-    maps_.clear();
+    blocker_ = {};
+    blocking_.reset();
+    endgame_.reset();
+    redundant_.clear();
+    ending_ = false;
+    endgame_top_.store(zero, std::memory_order_relaxed);
     notify(error::success, chase::purge, branch_point);
 }
 
@@ -370,6 +678,11 @@ void chaser_check::do_checked(height_t height) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // The checked event is the association of the candidate at height, so
+    // the height is indexed without searching the store. Heights above a
+    // reorganization branch point are reset by do_organized.
+    associated_.set(height);
+
     // Candidate block was checked at the given height, advance.
     if (height == add1(position()))
         do_bump(height);
@@ -382,22 +695,44 @@ void chaser_check::do_bump(height_t) NOEXCEPT
         return;
 
     const auto& query = archive();
-    auto height = position();
+    const auto previous = position();
+    auto height = previous;
 
-    // TODO: query.is_associated() is expensive (hashmap search).
-    // Skip checked blocks starting immediately after last checked.
-    while (!closed() && query.is_associated(
-        query.to_candidate((height = add1(height)))))
+    // Skip checked blocks starting immediately after last checked. Checked
+    // heights are indexed, so the store is searched only at an unindexed
+    // height, which is generally the next unassociated (hashmap search).
+    while (!closed())
     {
-        set_position(height);
+        const auto next = associated_.next_unset(add1(height));
+        height = sub1(next);
+        if (!query.is_associated(query.to_candidate(next)))
+            break;
+
+        associated_.set(next);
+        height = next;
     }
 
-    do_headers(sub1(height));
+    set_position(height);
+    associated_.trim(height);
+    if (height > previous)
+        set_advanced(height);
+
+    do_headers(height);
 }
 
 // add headers
 // ----------------------------------------------------------------------------
 
+void chaser_check::do_organized(height_t branch_point) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Candidates above the branch point are replaced, so are not indexed.
+    associated_.reset_above(branch_point);
+    reset_unissued(branch_point);
+    do_headers(branch_point);
+}
+
 void chaser_check::do_headers(height_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
@@ -417,12 +752,13 @@ bool chaser_check::purging() const NOEXCEPT
     return !job_;
 }
 
-void chaser_check::get_hashes(map_handler&& handler) NOEXCEPT
+void chaser_check::get_hashes(object_key channel,
+    map_handler&& handler) NOEXCEPT
 {
     if (closed())
         return;
 
-    POST(do_get_hashes, std::move(handler));
+    POST(do_get_hashes, channel, std::move(handler));
 }
 
 void chaser_check::put_hashes(const map_ptr& map,
@@ -434,13 +770,14 @@ void chaser_check::put_hashes(const map_ptr& map,
     POST(do_put_hashes, map, std::move(handler));
 }
 
-void chaser_check::do_get_hashes(const map_handler& handler) NOEXCEPT
+void chaser_check::do_get_hashes(object_key channel,
+    const map_handler& handler) NOEXCEPT
 {
     BC_ASSERT(stranded());
     if (closed() || purging())
         return;
 
-    handler(error::success, get_map(), job_);
+    handler(error::success, get_map(channel), job_);
 }
 
 void chaser_check::do_put_hashes(const map_ptr& map,
@@ -451,6 +788,7 @@ void chaser_check::do_put_hashes(const map_ptr& map,
     if (closed() || purging())
         return;
 
+    filter_returned(*map);
     if (set_map(map))
         notify(error::success, chase::download, map->size());
 
@@ -460,26 +798,99 @@ void chaser_check::do_put_hashes(const map_ptr& map,
 // utilities
 // ----------------------------------------------------------------------------
 
-map_ptr chaser_check::get_map() NOEXCEPT
+// Work is issued lowest height first, so that validation is fed continuously,
+// in a batch sized to the channel's measured rate. The frontier (which blocks
+// validation) is reserved for fast channels, so a slow channel is issued the
+// highest work, unless there is no more than its batch to issue.
+map_ptr chaser_check::get_map(object_key channel) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    return maps_.empty() ? empty_map() : pop_front(maps_);
+    if (unissued_.empty())
+        return get_redundant(channel);
+
+    const auto size = get_batch_size(channel);
+    const auto& index = unissued_.get<association::pos>();
+    const auto frontier = is_frontier(index.begin()->context.height);
+    const auto highest = frontier && !is_fast(channel) &&
+        unissued_.size() > size;
+
+    const auto map = get_unissued(size, highest);
+    if (frontier && !highest)
+    {
+        frontier_ = map->pos_begin()->context.height;
+        blocker_ = channel;
+        blocking_ = std::make_shared<associations>(*map);
+        LOGV("Frontier work (" << map->size() << ") at (" << frontier_
+            << ") to channel [" << channel << "].");
+    }
+
+    fire(events::download_batch, map->size());
+    return map;
+}
+
+// The frontier is the next height required by validation.
+bool chaser_check::is_frontier(height_t bottom) const NOEXCEPT
+{
+    return bottom <= add1(position());
+}
+
+// Without sufficient measurements all channels are considered fast.
+bool chaser_check::is_fast(object_key channel) const NOEXCEPT
+{
+    if (speeds_.size() < minimum_for_standard_deviation)
+        return true;
+
+    double speed{};
+    return speeds_.get(speed, channel) && speed >= get_center();
+}
+
+// The median is not moved by a single fast (or slow) outlier channel.
+double chaser_check::get_center() const NOEXCEPT
+{
+    return robust_deviation_ ? speeds_.median() : speeds_.mean();
 }
 
+// The even share of work (inventory_) is scaled by the channel's rate relative
+// to the center rate (as is_fast). Unmeasured channels are scaled by their
+// persisted rate, if any, otherwise issued the even share.
+size_t chaser_check::get_batch_size(object_key channel) const NOEXCEPT
+{
+    constexpr auto maximum = messages::peer::max_inventory;
+    if (speeds_.size() < minimum_for_standard_deviation)
+        return inventory_;
+
+    double speed{};
+    if (!speeds_.get(speed, channel))
+    {
+        const auto prior = priors_.find(channel);
+        if (prior == priors_.end())
+            return inventory_;
+
+        speed = prior->second;
+    }
+
+    const auto center = get_center();
+    if (!(center > 0.0))
+        return inventory_;
+
+    const auto scaled = to_integer<size_t>(inventory_ * (speed / center));
+    return std::clamp<size_t>(scaled, one, maximum);
+}
+
+// Returned work is reissued (by height) with unissued work.
 bool chaser_check::set_map(const map_ptr& map) NOEXCEPT
 {
-    // Called from start.
-    ////BC_ASSERT(stranded());
+    BC_ASSERT(stranded());
     BC_ASSERT(map->size() <= messages::peer::max_inventory);
     if (map->empty())
         return false;
 
-    maps_.push_back(map);
+    unissued_.merge(*map);
     return true;
 }
 
-// Get all unassociated block records from start to stop heights.
-// Groups records into table sets by inventory set size, limited by advance.
+// Get all unassociated block records up to stop height, scanning only
+// candidates above the cursor, into unissued work.
 // Return the total number of records obtained and set requested_ to last.
 size_t chaser_check::set_unassociated() NOEXCEPT
 {
@@ -499,38 +910,95 @@ size_t chaser_check::set_unassociated() NOEXCEPT
 
     // Due to previous downloads, validation can race ahead of last request.
     // The last request (requested_) stops at the last gap in the window, but
-    // validation continues until the next gap. Start next scan above validated
-    // not last requested, since all between are already downloaded.
-    const auto& query = archive();
+    // validation continues until the next gap. Scan continues from the cursor,
+    // and work is cut into batches as it is issued (by channel rate).
+    // The window is limited in blocks and in estimated bytes (by height), so
+    // that a roughly constant amount of data is outstanding at any height.
     const auto requested = requested_;
-    const auto step = ceilinged_add(position(), maximum_concurrency_);
+    const auto limit = std::min(maximum_concurrency_,
+        floored_subtract(maximum_height_, position()));
+    const auto window = block_sizes::span(position(), maximum_window_bytes_,
+        limit);
+    const auto step = ceilinged_add(position(), window);
     const auto stop = std::min(step, maximum_height_);
-    size_t count{};
+    const auto before = unissued_.size();
+    const auto scanned = scan_unassociated(stop);
+    const auto count = unissued_.size() - before;
 
-    while (true)
+    if (is_nonzero(count))
     {
-        // Calls query.is_associated() per block, expensive (hashmap search).
-        const auto map = std::make_shared<associations>(
-            query.get_unassociated_above(requested_, inventory_, stop));
-
-        if (!set_map(map))
-            break;
-
-        requested_ = map->top().height;
-        count += map->size();
+        const auto& index = unissued_.get<association::pos>();
+        requested_ = std::prev(index.end())->context.height;
     }
 
     LOGN("Advance by ("
-        << maximum_concurrency_ << ") above ("
+        << window << ") above ("
         << requested << ") from ("
         << position() << ") stop ("
-        << stop << ") found ("
+        << stop << ") scanned ("
+        << scanned << ") found ("
         << count << ") last ("
         << requested_ << ").");
 
     return count;
 }
 
+// Scan candidates above the cursor up to stop (or top candidate), adding
+// unassociated records to unissued work. Each candidate height is scanned once
+// unless the candidate chain is reorganized below it (reset_unissued).
+size_t chaser_check::scan_unassociated(size_t stop) NOEXCEPT
+{
+    const auto& query = archive();
+    const auto last = std::min(stop, query.get_top_candidate());
+    const auto start = scanned_;
+
+    while (scanned_ < last)
+    {
+        // Skip heights indexed as associated, which are not searched.
+        scanned_ = std::min(last,
+            std::max(scanned_, sub1(associated_.next_unset(add1(scanned_)))));
+        if (scanned_ == last)
+            break;
+
+        // Calls query.is_associated() per unindexed block (hashmap search).
+        auto found = query.get_unassociated_above(scanned_, inventory_, last);
+        const auto full = found.size() == inventory_;
+        scanned_ = full ? found.top().height : last;
+        unissued_.merge(found);
+    }
+
+    return scanned_ > start ? scanned_ - start : zero;
+}
+
+// Move up to count lowest (or highest) unissued records into a map.
+map_ptr chaser_check::get_unissued(size_t count, bool highest) NOEXCEPT
+{
+    const auto map = empty_map();
+    auto& index = unissued_.get<association::pos>();
+    const auto size = std::min(count, index.size());
+
+    if (highest)
+        map->merge(index, std::prev(index.end(), size), index.end());
+    else
+        map->merge(index, index.begin(), std::next(index.begin(), size));
+
+    return map;
+}
+
+// Discard unissued work and rewind the cursor above the branch point.
+void chaser_check::reset_unissued(size_t branch_point) NOEXCEPT
+{
+    auto& index = unissued_.get<association::pos>();
+    const auto above = std::find_if(index.begin(), index.end(),
+        [=](const association& item) NOEXCEPT
+        {
+            return item.context.height > branch_point;
+        });
+
+    index.erase(above, index.end());
+    scanned_ = std::min(scanned_, branch_point);
+}
+
 size_t chaser_check::get_inventory_size() const NOEXCEPT
 {
     if (is_zero(connections_) || !is_current(false))
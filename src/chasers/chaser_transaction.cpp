@@ -100,6 +100,7 @@ void chaser_transaction::do_store(const transaction::cptr&) NOEXCEPT
     BC_ASSERT(stranded());
 
     // TODO: validate and store transaction.
+    // TODO: cache connected scripts for blocks.
 
     // Relay notification.
     ////notify(error::success, chase::transaction, link);
@@ -18,7 +18,14 @@
  */
 #include <bitcoin/node/chasers/chaser_validate.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
@@ -30,19 +37,26 @@ namespace node {
 
 using namespace system;
 using namespace database;
+using namespace std::chrono;
 using namespace std::placeholders;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 // Independent threadpool and strand (base class strand uses network pool).
+// Store reads ahead of validation are issued from a single thread.
 chaser_validate::chaser_validate(full_node& node) NOEXCEPT
   : chaser(node),
     validation_threadpool_(node.node_settings().threads_(),
         node.node_settings().thread_priority_()),
+    prefetch_threadpool_(one, node.node_settings().thread_priority_()),
+    prefetch_(node.node_settings().prefetch_blocks),
     validation_strand_(validation_threadpool_.service().get_executor()),
+    memory_(node.get_memory()),
     subsidy_interval_(node.system_settings().subsidy_interval_blocks),
     initial_subsidy_(node.system_settings().initial_subsidy()),
     maximum_backlog_(node.node_settings().maximum_concurrency_()),
+    threads_(node.node_settings().threads_()),
+    parallel_connect_(node.node_settings().parallel_connect),
     node_witness_(node.network_settings().witness_node()),
     defer_(node.node_settings().defer_validation),
     filter_(!defer_ && node.archive().filter_enabled())
@@ -114,6 +128,11 @@ bool chaser_validate::handle_event(const code&, chase event_,
 void chaser_validate::do_regressed(height_t branch_point) NOEXCEPT
 {
     BC_ASSERT(stranded());
+
+    // Blocks read ahead (also above position) may no longer be candidates.
+    prefetch_.clear();
+    prefetched_ = zero;
+
     if (branch_point >= position())
         return;
 
@@ -126,7 +145,22 @@ void chaser_validate::do_checked(height_t height) NOEXCEPT
 
     // Cannot validate next block until all previous blocks are archived.
     if (height == add1(position()))
+    {
         do_bumped(height);
+        return;
+    }
+
+    // A block archived above the next to validate is read ahead of posting.
+    if (height > add1(position()) &&
+        height <= ceilinged_add(add1(position()), prefetch_.capacity()))
+    {
+        const auto link = archive().to_candidate(height);
+        if (is_postable(link, height))
+        {
+            prefetch_.push(link.value, height);
+            do_prefetch();
+        }
+    }
 }
 
 void chaser_validate::do_bump(height_t) NOEXCEPT
@@ -146,6 +180,10 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
     BC_ASSERT(stranded());
     const auto& query = archive();
 
+    // Blocks read ahead at or below position but not posted (state changed
+    // or bypassed) are never taken, so are evicted to free read-ahead slots.
+    prefetch_.evict(position());
+
     // Bypass until next event if validation backlog is full.
     // Stop when suspended as write error des not terminate asynchronous loop.
     while ((backlog_ < maximum_backlog_) && !closed() && !suspended())
@@ -156,7 +194,10 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
         // Must exit on unassociated so they are not set valid in bypass.
         // Given height-based iteration, any block state may be enountered.
         if (ec == database::error::unassociated)
+        {
+            prefetch_above(height);
             return;
+        }
 
         const auto bypass = defer_ || is_under_checkpoint(height) ||
             query.is_milestone(link);
@@ -167,7 +208,7 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
             case database::error::unknown_state:
             {
                 if (!bypass || filter_)
-                    post_block(link, bypass);
+                    post_block(link, height, bypass);
                 else
                     complete_block(error::success, link, height, true);
                 break;
@@ -196,14 +237,79 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
     }
 }
 
-void chaser_validate::post_block(const header_link& link,
+void chaser_validate::post_block(const header_link& link, size_t height,
     bool bypass) NOEXCEPT
 {
     BC_ASSERT(stranded());
     backlog_.fetch_add(one, std::memory_order_relaxed);
+
+    // Read is dispatched ahead of posting (if not already read ahead).
+    prefetch_.post(link.value, height);
+    do_prefetch();
     PARALLEL(validate_block, link, bypass);
 }
 
+// Blocks that will be posted (not bypassed or already validated).
+bool chaser_validate::is_postable(const header_link& link,
+    size_t height) const NOEXCEPT
+{
+    const auto& query = archive();
+    const auto ec = query.get_block_state(link);
+    if (ec != database::error::unvalidated &&
+        ec != database::error::unknown_state)
+        return false;
+
+    return filter_ || !(defer_ || is_under_checkpoint(height) ||
+        query.is_milestone(link));
+}
+
+// Read ahead (concurrent)
+// ----------------------------------------------------------------------------
+
+// Blocks archived above an unassociated height (gap) are read ahead of their
+// posting, within the read-ahead window above the gap. The window is filled
+// only when the gap advances, as blocks archived later within it are pushed
+// by do_checked.
+void chaser_validate::prefetch_above(height_t gap) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (!prefetch_.enabled() || gap <= prefetched_)
+        return;
+
+    prefetched_ = gap;
+
+    const auto& query = archive();
+    const auto top = ceilinged_add(gap, prefetch_.capacity());
+    for (auto height = add1(gap); height <= top && !closed(); ++height)
+    {
+        const auto link = query.to_candidate(height);
+        if (is_postable(link, height))
+            prefetch_.push(link.value, height);
+    }
+
+    do_prefetch();
+}
+
+// Thread safe, dispatches queued reads up to prefetch capacity.
+void chaser_validate::do_prefetch() NOEXCEPT
+{
+    header_t link{};
+    while (!closed() && prefetch_.next(link))
+        boost::asio::post(prefetch_threadpool_.service(),
+            BIND(prefetch_block, header_link{ link }));
+}
+
+// Reading the wire block faults its pages in ahead of validation threads.
+// Skipped if validation took the block before its read began.
+void chaser_validate::prefetch_block(const header_link& link) NOEXCEPT
+{
+    if (!prefetch_.begin(link.value))
+        return;
+
+    prefetch_.put(link.value, closed() ? data_chunk{} :
+        archive().get_wire_block(link, node_witness_));
+}
+
 // Unstranded (concurrent by block)
 // ----------------------------------------------------------------------------
 
@@ -217,9 +323,7 @@ void chaser_validate::validate_block(const header_link& link,
     chain::context ctx{};
     auto& query = archive();
 
-    // TODO: implement allocator parameter resulting in full allocation to
-    // shared_ptr<block>, to optimize deallocate (12% of milestone/filter).
-    const auto block = query.get_block(link, node_witness_);
+    const auto block = get_block(link);
 
     if (!block)
     {
@@ -234,7 +338,7 @@ void chaser_validate::validate_block(const header_link& link,
         if (!query.set_block_unconfirmable(link))
             ec = error::validate4;
     }
-    else if ((ec = validate(bypass, *block, link, ctx)))
+    else if ((ec = validate(bypass, block, link, ctx)))
     {
         if (!query.set_block_unconfirmable(link))
             ec = error::validate5;
@@ -247,6 +351,50 @@ void chaser_validate::validate_block(const header_link& link,
         handle_event(error::success, chase::bump, height_t{});
 }
 
+// Validation threads lease arenas from the node memory controller, so the
+// deserialized block is released in one call when the block destructs. This
+// avoids piecewise deallocation (12% of milestone/filter), at the cost of
+// reading the block from the store in wire form. A block read ahead is taken
+// in wire form (waiting on its read if in flight), otherwise it is read here.
+// Time blocked on either is reported.
+chain::block::cptr chaser_validate::get_block(
+    const header_link& link) NOEXCEPT
+{
+    using namespace network::messages::peer;
+    const auto& query = archive();
+    const auto arena = memory_.get_arena();
+    const auto start = steady_clock::now();
+    auto data = prefetch_.take(link.value);
+    chain::block::cptr block{};
+
+    if (data.empty())
+    {
+        // Allocation is disabled, so allocate piecewise from store records.
+        if (arena == default_arena::get())
+            block = query.get_block(link, node_witness_);
+        else
+            data = query.get_wire_block(link, node_witness_);
+    }
+
+    const auto span = duration_cast<microseconds>(steady_clock::now() -
+        start);
+    fire(events::prefetch_wait_usecs, sign_cast<uint64_t>(span.count()));
+
+    if (prefetch_.enabled())
+    {
+        fire(events::prefetch_hit_rate, prefetch_.hit_rate());
+        do_prefetch();
+    }
+
+    if (block || data.empty())
+        return block;
+
+    const auto message = block::deserialize(*arena, level::maximum_protocol,
+        data, node_witness_);
+
+    return message ? message->block_ptr : nullptr;
+}
+
 code chaser_validate::populate(bool bypass, const chain::block& block,
     const chain::context& ctx) NOEXCEPT
 {
@@ -274,7 +422,7 @@ code chaser_validate::populate(bool bypass, const chain::block& block,
     return error::success;
 }
 
-code chaser_validate::validate(bool bypass, const chain::block& block,
+code chaser_validate::validate(bool bypass, const chain::block::cptr& block,
     const database::header_link& link, const chain::context& ctx) NOEXCEPT
 {
     auto& query = archive();
@@ -282,18 +430,19 @@ code chaser_validate::validate(bool bypass, const chain::block& block,
     if (!bypass)
     {
         code ec{};
-        if ((ec = block.accept(ctx, subsidy_interval_, initial_subsidy_)))
+        if ((ec = block->accept(ctx, subsidy_interval_, initial_subsidy_)))
             return ec;
 
-        if ((ec = block.connect(ctx)))
+        // Scripts are verified (and joined) before prevouts are stored.
+        if ((ec = connect(block, ctx)))
             return ec;
 
         // Prevouts optimize confirmation.
-        if (!query.set_prevouts(link, block))
+        if (!query.set_prevouts(link, *block))
             return error::validate6;
     }
 
-    if (!query.set_filter_body(link, block))
+    if (!query.set_filter_body(link, *block))
         return error::validate7;
 
     // Valid must be set after set_prevouts and set_filter_body.
@@ -303,6 +452,113 @@ code chaser_validate::validate(bool bypass, const chain::block& block,
     return error::success;
 }
 
+// Intra-block parallelism (concurrent)
+// ----------------------------------------------------------------------------
+
+// Shared by the validating thread and its helpers, which may outlive connect.
+// Helpers also share ownership of the block, as its transactions are allocated
+// from the block's arena, which is released when the block destructs.
+struct chaser_validate::connection
+{
+    connection(size_t count) NOEXCEPT
+      : remaining(count)
+    {
+    }
+
+    // Coinbase (first) is not connected.
+    std::atomic<size_t> next{ one };
+    std::atomic<size_t> remaining;
+    std::atomic_bool failed{};
+
+    // These are protected by mutex.
+    code ec{};
+    std::mutex mutex{};
+    std::condition_variable joined{};
+};
+
+// Validation threads are occupied by block (backlog) when it is deep, so only
+// a large block with a shallow backlog is shared with idle threads.
+size_t chaser_validate::idle_threads(const chain::block& block) const NOEXCEPT
+{
+    if (is_zero(parallel_connect_) || block.transactions() < parallel_connect_)
+        return zero;
+
+    // The backlog includes this block.
+    const auto backlog = backlog_.load(std::memory_order_relaxed);
+    return floored_subtract(threads_, backlog);
+}
+
+// TODO: batch verify the block's BIP340 signatures (requires a secp256k1
+// batch verification interface in system, which does not yet exist).
+code chaser_validate::connect(const chain::block::cptr& block,
+    const chain::context& ctx) NOEXCEPT
+{
+    const auto helpers = idle_threads(*block);
+    if (is_zero(helpers))
+        return block->connect(ctx);
+
+    // Block sigop limit precedes script verification, as in block.connect.
+    const auto bip16 = ctx.is_enabled(chain::flags::bip16_rule);
+    const auto bip141 = ctx.is_enabled(chain::flags::bip141_rule);
+    const auto limit = bip141 ? max_fast_sigops : max_block_sigops;
+    if (block->signature_operations(bip16, bip141) > limit)
+        return system::error::block_sigop_limit;
+
+    // Batches are taken from a shared cursor by whichever thread is free, so
+    // helpers that start late (or never) leave the remainder to others.
+    const auto count = sub1(block->transactions());
+    const auto batch = std::max(one, count / (add1(helpers) * 4u));
+
+    const auto state = std::make_shared<connection>(count);
+
+    for (size_t helper = 0; helper < helpers; ++helper)
+        boost::asio::post(validation_threadpool_.service(),
+            std::bind(&chaser_validate::connect_batches, block, ctx, state,
+                batch));
+
+    connect_batches(block, ctx, state, batch);
+
+    // Join all batches, including those still being verified by helpers.
+    std::unique_lock lock(state->mutex);
+    state->joined.wait(lock, [&]() NOEXCEPT
+    {
+        return is_zero(state->remaining.load());
+    });
+
+    return state->ec;
+}
+
+void chaser_validate::connect_batches(const chain::block::cptr& block,
+    const chain::context& ctx, const connection_ptr& state,
+    size_t batch) NOEXCEPT
+{
+    const auto& txs = *block->transactions_ptr();
+    const auto size = txs.size();
+    size_t start{};
+    while ((start = state->next.fetch_add(batch)) < size)
+    {
+        const auto stop = std::min(ceilinged_add(start, batch), size);
+
+        // After any failure remaining batches are counted but not verified.
+        code ec{};
+        for (auto index = start; index < stop && !state->failed; ++index)
+        {
+            if ((ec = txs.at(index)->connect(ctx)))
+                break;
+        }
+
+        std::unique_lock lock(state->mutex);
+        if (ec && !state->failed)
+        {
+            state->ec = ec;
+            state->failed = true;
+        }
+
+        if (is_zero(state->remaining -= (stop - start)))
+            state->joined.notify_all();
+    }
+}
+
 // May be either concurrent or stranded.
 void chaser_validate::complete_block(const code& ec, const header_link& link,
     size_t height, bool bypass) NOEXCEPT
@@ -343,12 +599,13 @@ void chaser_validate::stopping(const code& ec) NOEXCEPT
 {
     // Stop threadpool keep-alive, all work must self-terminate to affect join.
     validation_threadpool_.stop();
+    prefetch_threadpool_.stop();
     chaser::stopping(ec);
 }
 
 void chaser_validate::stop() NOEXCEPT
 {
-    if (!validation_threadpool_.join())
+    if (!validation_threadpool_.join() || !prefetch_threadpool_.join())
     {
         BC_ASSERT_MSG(false, "failed to join threadpool");
         std::abort();
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/chunk_pool.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+chunk_pool::chunk_pool(size_t limit, const total_ptr& total) NOEXCEPT
+  : limit_{ limit },
+    total_{ total ? total : std::make_shared<std::atomic_size_t>() }
+{
+}
+
+chunk_pool::~chunk_pool() NOEXCEPT
+{
+    BC_ASSERT_MSG(is_zero(retained_), "undrained chunk pool");
+}
+
+void* chunk_pool::pop(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size == to_class(size));
+    std::lock_guard lock(mutex_);
+
+    const auto it = classes_.find(size);
+    if (it == classes_.end() || it->second.empty())
+    {
+        misses_.fetch_add(one, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const auto chunk = it->second.back();
+    it->second.pop_back();
+    retained_.fetch_sub(size, std::memory_order_relaxed);
+    total_->fetch_sub(size, std::memory_order_relaxed);
+    hits_.fetch_add(one, std::memory_order_relaxed);
+    return chunk;
+}
+
+bool chunk_pool::push(void* chunk, size_t size) NOEXCEPT
+{
+    BC_ASSERT(!is_null(chunk));
+    BC_ASSERT(size == to_class(size));
+    std::lock_guard lock(mutex_);
+
+    // The total is shared with other pools, so the limit is reserved against
+    // it atomically.
+    auto total = total_->load(std::memory_order_relaxed);
+    do
+    {
+        if (ceilinged_add(total, size) > limit_)
+            return false;
+    }
+    while (!total_->compare_exchange_weak(total, total + size,
+        std::memory_order_relaxed));
+
+    classes_[size].push_back(chunk);
+    retained_.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+void* chunk_pool::drain() NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+
+    for (auto& [size, chunks]: classes_)
+    {
+        if (!chunks.empty())
+        {
+            const auto chunk = chunks.back();
+            chunks.pop_back();
+            retained_.fetch_sub(size, std::memory_order_relaxed);
+            total_->fetch_sub(size, std::memory_order_relaxed);
+            return chunk;
+        }
+    }
+
+    return nullptr;
+}
+
+// properties
+// ----------------------------------------------------------------------------
+
+size_t chunk_pool::limit() const NOEXCEPT
+{
+    return limit_;
+}
+
+size_t chunk_pool::retained() const NOEXCEPT
+{
+    return retained_.load(std::memory_order_relaxed);
+}
+
+size_t chunk_pool::hits() const NOEXCEPT
+{
+    return hits_.load(std::memory_order_relaxed);
+}
+
+size_t chunk_pool::misses() const NOEXCEPT
+{
+    return misses_.load(std::memory_order_relaxed);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -18,6 +18,7 @@
  */
 #include <bitcoin/node/full_node.hpp>
 
+#include <filesystem>
 #include <utility>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
@@ -38,11 +39,17 @@ full_node::full_node(query& query, const configuration& configuration,
     const logger& log) NOEXCEPT
   : net(configuration.network, log),
     config_(configuration),
-    memory_(config_.node.allocation_multiple, config_.network.threads),
+    memory_(config_.node.allocation_multiple, config_.network.threads,
+        config_.node.allocation_retain_bytes,
+        config_.node.allocation_huge_pages,
+        config_.node.allocation_numa,
+        config_.node.allocation_adaptive),
+    history_(config_.node.history_capacity),
     query_(query),
     chaser_block_(*this),
     chaser_header_(*this),
     chaser_check_(*this),
+    chaser_archive_(*this),
     chaser_validate_(*this),
     chaser_confirm_(*this),
     chaser_transaction_(*this),
@@ -67,6 +74,9 @@ void full_node::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
+    // Fast peers of the prior run are known before any connection is made.
+    load_history();
+
     // Base (net) invokes do_start().
     net::start(std::move(handler));
 }
@@ -80,6 +90,7 @@ void full_node::do_start(const result_handler& handler) NOEXCEPT
             chaser_header_.start() :
             chaser_block_.start()))) ||
         ((ec = chaser_check_.start())) ||
+        ((ec = chaser_archive_.start())) ||
         ((ec = chaser_validate_.start())) ||
         ((ec = chaser_confirm_.start())) ||
         ((ec = chaser_transaction_.start())) ||
@@ -114,6 +125,15 @@ void full_node::do_run(const result_handler& handler) NOEXCEPT
     // This will kick off lagging validations even if not current.
     do_notify(error::success, chase::start, height_t{});
 
+    // Report block memory telemetry each sample period.
+    if (to_bool(config_.node.sample_period_seconds))
+    {
+        memory_timer_ = std::make_shared<deadline>(log, strand(),
+            config_.node.sample_period());
+        memory_timer_->start(std::bind(&full_node::handle_memory_timer,
+            this, _1));
+    }
+
     // Start services after network is running.
     net::do_run(handler);
 }
@@ -127,12 +147,16 @@ void full_node::close() NOEXCEPT
     chaser_header_.stop();
     chaser_block_.stop();
     chaser_check_.stop();
+    chaser_archive_.stop();
     chaser_validate_.stop();
     chaser_confirm_.stop();
     chaser_transaction_.stop();
     chaser_template_.stop();
     chaser_snapshot_.stop();
     chaser_storage_.stop();
+
+    // All channels are stopped, so history is complete.
+    save_history();
 }
 
 // Base (net) invokes do_close().
@@ -144,6 +168,7 @@ void full_node::do_close() NOEXCEPT
     chaser_header_.stopping(network::error::service_stopped);
     chaser_block_.stopping(network::error::service_stopped);
     chaser_check_.stopping(network::error::service_stopped);
+    chaser_archive_.stopping(network::error::service_stopped);
     chaser_validate_.stopping(network::error::service_stopped);
     chaser_confirm_.stopping(network::error::service_stopped);
     chaser_transaction_.stopping(network::error::service_stopped);
@@ -151,6 +176,12 @@ void full_node::do_close() NOEXCEPT
     chaser_snapshot_.stopping(network::error::service_stopped);
     chaser_storage_.stopping(network::error::service_stopped);
 
+    if (memory_timer_)
+    {
+        memory_timer_->stop();
+        memory_timer_.reset();
+    }
+
     event_subscriber_.stop(network::error::service_stopped, chase::stop, {});
     net::do_close();
 }
@@ -170,9 +201,10 @@ void full_node::organize(const system::chain::block::cptr& block,
     chaser_block_.organize(block, std::move(handler));
 }
 
-void full_node::get_hashes(map_handler&& handler) NOEXCEPT
+void full_node::get_hashes(object_key channel,
+    map_handler&& handler) NOEXCEPT
 {
-    chaser_check_.get_hashes(std::move(handler));
+    chaser_check_.get_hashes(channel, std::move(handler));
 }
 
 void full_node::put_hashes(const map_ptr& map,
@@ -181,6 +213,14 @@ void full_node::put_hashes(const map_ptr& map,
     chaser_check_.put_hashes(map, std::move(handler));
 }
 
+void full_node::write_block(const system::chain::block::cptr& block,
+    const database::header_link& link, const system::chain::context& ctx,
+    bool checked, bool bypass, result_handler&& handler) NOEXCEPT
+{
+    chaser_archive_.write(block, link, ctx, checked, bypass,
+        std::move(handler));
+}
+
 // Events.
 // ----------------------------------------------------------------------------
 
@@ -427,10 +467,60 @@ bool full_node::is_recent() const NOEXCEPT
 // Session attachments.
 
 // ----------------------------------------------------------------------------
-void full_node::performance(object_key key, uint64_t speed,
+// Only outbound channels are shed toward the (outbound) target.
+void full_node::performance(object_key key, uint64_t speed, bool inbound,
     result_handler&& handler) NOEXCEPT
 {
-    chaser_check_.update(key, speed, std::move(handler));
+    const auto excess = !inbound &&
+        outbound_channel_count() > chaser_check_.outbound_target();
+    chaser_check_.update(key, speed, excess, std::move(handler));
+}
+
+void full_node::prior_performance(object_key key, uint64_t speed) NOEXCEPT
+{
+    chaser_check_.prior(key, speed);
+}
+
+peer_history& full_node::get_history() NOEXCEPT
+{
+    return history_;
+}
+
+// Manual channels are counted as outbound. Pending attempts are counted
+// against the target, as otherwise each connection loop is admitted before any
+// channel is established. An attempt that does not connect (including the
+// losers of a connect batch) is released after one sample period, which is
+// the interval at which the target is adapted.
+bool full_node::admit_outbound() NOEXCEPT
+{
+    const auto target = chaser_check_.outbound_target();
+    if (target == max_size_t)
+        return true;
+
+    const auto now = steady_clock::now();
+    const auto period = config_.node.sample_period();
+
+    std::unique_lock lock(pending_mutex_);
+    while (!pending_.empty() && now - pending_.front() >= period)
+        pending_.pop_front();
+
+    if (ceilinged_add(outbound_channel_count(), pending_.size()) >= target)
+        return false;
+
+    pending_.push_back(now);
+    return true;
+}
+
+void full_node::outbound_connected() NOEXCEPT
+{
+    std::unique_lock lock(pending_mutex_);
+    if (!pending_.empty())
+        pending_.pop_front();
+}
+
+bool full_node::is_endgame(size_t height) const NOEXCEPT
+{
+    return chaser_check_.is_endgame(height);
 }
 
 network::memory& full_node::get_memory() NOEXCEPT
@@ -438,6 +528,105 @@ network::memory& full_node::get_memory() NOEXCEPT
     return memory_;
 }
 
+const full_node::memory_controller&
+full_node::get_memory_controller() const NOEXCEPT
+{
+    return memory_;
+}
+
+// private
+// Manual channels are not inbound, so are counted as outbound.
+size_t full_node::outbound_channel_count() const NOEXCEPT
+{
+    return floored_subtract(channel_count(), inbound_channel_count());
+}
+
+// private
+void full_node::handle_memory_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !memory_timer_ ||
+        ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Memory telemetry timer fault, " << ec.message());
+        return;
+    }
+
+    report_memory();
+    memory_timer_->start(std::bind(&full_node::handle_memory_timer,
+        this, _1));
+}
+
+// private
+void full_node::report_memory() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Counters are cumulative, so rates are reported as period deltas.
+    const auto padding = memory_.padding();
+    const auto detached = memory_.detached();
+    const auto released = memory_.released();
+    const auto chained = memory_.chained();
+
+    fire(events::memory_in_flight, memory_.in_flight());
+    fire(events::memory_padding, padding - padding_);
+    fire(events::memory_largest, memory_.largest());
+    fire(events::memory_detached, detached - detached_);
+    fire(events::memory_released, released - released_);
+    fire(events::memory_chained, chained - chained_);
+
+    padding_ = padding;
+    detached_ = detached;
+    released_ = released;
+    chained_ = chained;
+}
+
+// private
+// History is retained alongside the peer address cache (hosts file).
+std::filesystem::path full_node::history_file() const NOEXCEPT
+{
+    if (config_.network.path.empty() || is_zero(config_.node.history_capacity))
+        return {};
+
+    return config_.network.path / "history.cache";
+}
+
+// private
+void full_node::load_history() NOEXCEPT
+{
+    const auto file = history_file();
+    if (file.empty())
+        return;
+
+    if (!history_.load(file))
+    {
+        LOGN("Peer history not loaded from [" << file.string() << "].");
+        return;
+    }
+
+    history_.prefer(config_.node.history_preferred);
+    LOGN("Peer history (" << history_.size() << ") loaded.");
+}
+
+// private
+void full_node::save_history() NOEXCEPT
+{
+    const auto file = history_file();
+    if (file.empty())
+        return;
+
+    if (!history_.save(file))
+    {
+        LOGF("Peer history not saved to [" << file.string() << "].");
+        return;
+    }
+
+    LOGN("Peer history (" << history_.size() << ") saved.");
+}
+
 // Session attachments.
 // ----------------------------------------------------------------------------
 
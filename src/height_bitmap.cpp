@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/height_bitmap.hpp>
+
+#include <bit>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+height_bitmap::height_bitmap() NOEXCEPT
+  : floor_{ zero }, words_{}
+{
+}
+
+bool height_bitmap::is_set(size_t height) const NOEXCEPT
+{
+    if (height < floor_)
+        return false;
+
+    const auto offset = height - floor_;
+    const auto index = offset / word_bits;
+    if (index >= words_.size())
+        return false;
+
+    return to_bool((words_.at(index) >> (offset % word_bits)) & one);
+}
+
+size_t height_bitmap::next_unset(size_t height) const NOEXCEPT
+{
+    if (height < floor_)
+        return height;
+
+    const auto offset = height - floor_;
+    auto index = offset / word_bits;
+    auto shift = offset % word_bits;
+
+    // Skip full words, so a run of set heights costs one step per word.
+    for (; index < words_.size(); ++index, shift = zero)
+    {
+        const auto ones = std::countr_one(words_.at(index) >> shift);
+        if (possible_narrow_sign_cast<size_t>(ones) < word_bits - shift)
+            return floor_ + index * word_bits + shift + ones;
+    }
+
+    return std::max(height, floor_ + words_.size() * word_bits);
+}
+
+void height_bitmap::set(size_t height) NOEXCEPT
+{
+    extend(height);
+    const auto offset = height - floor_;
+    words_.at(offset / word_bits) |= (uint64_t{ 1 } << (offset % word_bits));
+}
+
+void height_bitmap::set(size_t first, size_t last) NOEXCEPT
+{
+    for (auto height = first; height <= last && height >= first; ++height)
+        set(height);
+}
+
+void height_bitmap::reset(size_t height) NOEXCEPT
+{
+    if (!is_set(height))
+        return;
+
+    const auto offset = height - floor_;
+    words_.at(offset / word_bits) &= ~(uint64_t{ 1 } << (offset % word_bits));
+}
+
+void height_bitmap::reset_above(size_t height) NOEXCEPT
+{
+    if (height < floor_)
+    {
+        clear();
+        return;
+    }
+
+    const auto offset = add1(height - floor_);
+    const auto index = offset / word_bits;
+    if (index >= words_.size())
+        return;
+
+    // Drop whole words above, mask the partial word.
+    const auto shift = offset % word_bits;
+    words_.resize(is_zero(shift) ? index : add1(index));
+    if (is_nonzero(shift))
+        words_.back() &= (full >> (word_bits - shift));
+}
+
+void height_bitmap::trim(size_t height) NOEXCEPT
+{
+    while (!words_.empty() && floor_ + word_bits <= height)
+    {
+        words_.pop_front();
+        floor_ += word_bits;
+    }
+}
+
+void height_bitmap::clear() NOEXCEPT
+{
+    words_.clear();
+}
+
+size_t height_bitmap::count() const NOEXCEPT
+{
+    size_t total{};
+    for (const auto word: words_)
+        total += possible_narrow_sign_cast<size_t>(std::popcount(word));
+
+    return total;
+}
+
+// protected
+void height_bitmap::extend(size_t height) NOEXCEPT
+{
+    // An empty bitmap is rebased at the height.
+    if (words_.empty())
+        floor_ = to_floor(height);
+
+    while (height < floor_)
+    {
+        words_.push_front(zero);
+        floor_ -= word_bits;
+    }
+
+    while (height >= floor_ + words_.size() * word_bits)
+        words_.push_back(zero);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
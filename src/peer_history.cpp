@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/peer_history.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+peer_history::peer_history(size_t capacity) NOEXCEPT
+  : capacity_(capacity), records_{}, ages_{}, preferred_{}, mutex_{}
+{
+}
+
+bool peer_history::load(const std::filesystem::path& file) NOEXCEPT
+{
+    std::ifstream in{ file };
+    if (!in.good())
+        return false;
+
+    std::lock_guard lock(mutex_);
+    records_.clear();
+    ages_.clear();
+    preferred_.clear();
+
+    // Lines are oldest first, so recency is restored.
+    std::string line{};
+    while (std::getline(in, line))
+    {
+        std::string peer{};
+        record value{};
+        std::istringstream fields{ line };
+        if (!(fields >> peer >> value.rate >> value.latency))
+            continue;
+
+        if (const auto prior = touch(peer))
+            *prior = value;
+        else
+            insert(peer, value);
+    }
+
+    return true;
+}
+
+bool peer_history::save(const std::filesystem::path& file) const NOEXCEPT
+{
+    // Written to a temporary and then renamed, so a failed write is benign.
+    auto temporary = file;
+    temporary += ".tmp";
+
+    {
+        std::ofstream out{ temporary, std::ios::trunc };
+        if (!out.good())
+            return false;
+
+        std::lock_guard lock(mutex_);
+        for (const auto& peer: ages_)
+        {
+            const auto& value = records_.at(peer).value;
+            out << peer << ' ' << value.rate << ' ' << value.latency << '\n';
+        }
+
+        out.flush();
+        if (!out.good())
+            return false;
+    }
+
+    std::error_code ec{};
+    std::filesystem::rename(temporary, file, ec);
+    return !ec;
+}
+
+void peer_history::set_rate(const std::string& peer, uint64_t rate) NOEXCEPT
+{
+    if (is_zero(rate))
+        return;
+
+    std::lock_guard lock(mutex_);
+    if (const auto prior = touch(peer))
+    {
+        prior->rate = is_zero(prior->rate) ? rate : smooth(prior->rate, rate);
+        return;
+    }
+
+    insert(peer, { rate, {} });
+}
+
+void peer_history::set_latency(const std::string& peer,
+    uint32_t latency) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    if (const auto prior = touch(peer))
+    {
+        prior->latency = is_zero(prior->latency) ? latency :
+            possible_narrow_cast<uint32_t>(smooth(prior->latency, latency));
+        return;
+    }
+
+    insert(peer, { {}, latency });
+}
+
+bool peer_history::get(record& out, const std::string& peer) const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    const auto it = records_.find(peer);
+    if (it == records_.end())
+        return false;
+
+    out = it->second.value;
+    return true;
+}
+
+uint64_t peer_history::rate(const std::string& peer) const NOEXCEPT
+{
+    record value{};
+    return get(value, peer) ? value.rate : zero;
+}
+
+void peer_history::prefer(size_t count) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    std::vector<std::pair<std::string, record>> ranked{};
+    ranked.reserve(records_.size());
+    for (const auto& [peer, item]: records_)
+        if (!is_zero(item.value.rate))
+            ranked.emplace_back(peer, item.value);
+
+    // Fastest first, lower latency breaks a tie.
+    std::sort(ranked.begin(), ranked.end(),
+        [](const auto& left, const auto& right) NOEXCEPT
+        {
+            if (left.second.rate != right.second.rate)
+                return left.second.rate > right.second.rate;
+
+            return left.second.latency < right.second.latency;
+        });
+
+    preferred_.clear();
+    const auto end = std::next(ranked.begin(),
+        std::min(count, ranked.size()));
+    for (auto it = ranked.begin(); it != end; ++it)
+        preferred_.push_back(it->first);
+}
+
+bool peer_history::next(std::string& out) NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    if (preferred_.empty())
+        return false;
+
+    out = std::move(preferred_.front());
+    preferred_.pop_front();
+    return true;
+}
+
+size_t peer_history::size() const NOEXCEPT
+{
+    std::lock_guard lock(mutex_);
+    return records_.size();
+}
+
+// protected
+uint64_t peer_history::smooth(uint64_t prior, uint64_t sample) NOEXCEPT
+{
+    // Overflow safe weighted average (prior * 3 + sample) / 4.
+    constexpr auto sample_weight = total_weight - prior_weight;
+    return (prior / total_weight) * prior_weight +
+        (sample / total_weight) * sample_weight +
+        ((prior % total_weight) * prior_weight +
+            (sample % total_weight) * sample_weight) / total_weight;
+}
+
+// protected
+// Get the record of the peer as most recently updated (mutex must be held).
+peer_history::record* peer_history::touch(const std::string& peer) NOEXCEPT
+{
+    const auto it = records_.find(peer);
+    if (it == records_.end())
+        return nullptr;
+
+    ages_.splice(ages_.end(), ages_, it->second.age);
+    return &it->second.value;
+}
+
+// protected
+// Add a peer, evicting the least recently updated (mutex must be held).
+void peer_history::insert(const std::string& peer,
+    const record& value) NOEXCEPT
+{
+    if (is_zero(capacity_))
+        return;
+
+    if (records_.size() >= capacity_)
+    {
+        records_.erase(ages_.front());
+        ages_.pop_front();
+    }
+
+    ages_.push_back(peer);
+    records_.emplace(peer, entry{ value, std::prev(ages_.end()) });
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -19,6 +19,7 @@
 #include <bitcoin/node/protocols/protocol_block_in_31800.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -32,6 +33,7 @@ using namespace system;
 using namespace database;
 using namespace network;
 using namespace network::messages::peer;
+using namespace std::chrono;
 using namespace std::placeholders;
 
 // Shared pointers required for lifetime in handler parameters.
@@ -72,7 +74,7 @@ void protocol_block_in_31800::subscribed(const code& ec, object_key) NOEXCEPT
     if (is_current(false))
     {
         start_performance();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+        get_work();
     }
 }
 
@@ -80,8 +82,7 @@ void protocol_block_in_31800::subscribed(const code& ec, object_key) NOEXCEPT
 void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    restore(map_);
-    map_ = chaser_check::empty_map();
+    restore_all();
     stop_performance();
     unsubscribe_events();
     protocol_performer::stopping(ec);
@@ -93,7 +94,7 @@ void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 bool protocol_block_in_31800::is_idle() const NOEXCEPT
 {
     BC_ASSERT(stranded());
-    return map_->empty();
+    return maps_.empty();
 }
 
 bool protocol_block_in_31800::handle_event(const code&, chase event_,
@@ -160,31 +161,45 @@ void protocol_block_in_31800::do_report(count_t sequence) NOEXCEPT
     BC_ASSERT(stranded());
 
     // Uses application logging since it outputs to a runtime option.
-    LOGA("Work report [" << sequence << "] is (" << map_->size() << ") for ["
-        << opposite() << "].");
+    LOGA("Work report [" << sequence << "] is (" << outstanding() << ") in ("
+        << maps_.size() << ") batches for [" << opposite() << "].");
 }
 
 void protocol_block_in_31800::do_get_downloads(count_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || !is_idle())
+    if (stopped())
+        return;
+
+    // New work is available, so a draining channel may request again. An
+    // outstanding request may have been answered before the new work.
+    exhausted_ = false;
+    announced_ = true;
+
+    // New work may be pipelined behind a draining batch.
+    if (!is_idle())
+    {
+        if (is_draining())
+            get_work();
+
         return;
+    }
 
     // Assume performance was stopped due to exhaustion.
     start_performance();
-    get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+    get_work();
 }
 
 void protocol_block_in_31800::do_purge(peer_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (map_->empty())
+    if (is_idle())
         return;
 
-    LOGV("Purge work (" << map_->size() << ") from [" << opposite() << "].");
-    map_->clear();
+    LOGV("Purge work (" << outstanding() << ") from [" << opposite() << "].");
+    maps_.clear();
     stop(error::sacrificed_channel);
 }
 
@@ -192,13 +207,21 @@ void protocol_block_in_31800::do_stall(peer_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || (map_->size() <= one))
+    if (stopped() || (outstanding() <= one))
+        return;
+
+    if (rebalance_)
+    {
+        rebalance();
         return;
+    }
+
+    LOGV("Divide work (" << outstanding() << ") from [" << opposite() << "].");
+    fire(events::download_sacrificed, outstanding());
+    for (const auto& map: maps_)
+        restore(chaser_check::split(map));
 
-    LOGV("Divide work (" << map_->size() << ") from [" << opposite() << "].");
-    restore(chaser_check::split(map_));
-    restore(map_);
-    map_ = chaser_check::empty_map();
+    restore_all();
     stop(error::sacrificed_channel);
 }
 
@@ -206,16 +229,49 @@ void protocol_block_in_31800::do_split(peer_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || (map_->size() <= one))
+    if (stopped() || (outstanding() <= one))
         return;
 
-    LOGV("Split work (" << map_->size() << ") from [" << opposite() << "].");
-    restore(chaser_check::split(map_));
-    restore(map_);
-    map_ = chaser_check::empty_map();
+    if (rebalance_)
+    {
+        rebalance();
+        return;
+    }
+
+    LOGV("Split work (" << outstanding() << ") from [" << opposite() << "].");
+    fire(events::download_sacrificed, outstanding());
+    for (const auto& map: maps_)
+        restore(chaser_check::split(map));
+
+    restore_all();
     stop(error::sacrificed_channel);
 }
 
+// Return the newest batch (or upper half of the only batch) and continue with
+// the remainder, avoiding reconnection. The returned blocks are the last the
+// peer would deliver, and if still delivered are ignored as unrequested.
+void protocol_block_in_31800::rebalance() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto count = outstanding();
+
+    if (maps_.size() > one)
+    {
+        const auto map = maps_.back();
+        maps_.pop_back();
+        restore(map);
+    }
+    else
+    {
+        restore(chaser_check::split_upper(maps_.front()));
+    }
+
+    const auto returned = count - outstanding();
+    LOGV("Rebalance work (" << returned << ") of (" << count << ") from ["
+        << opposite() << "].");
+    fire(events::download_rebalanced, returned);
+}
+
 // request hashes
 // ----------------------------------------------------------------------------
 
@@ -223,6 +279,8 @@ void protocol_block_in_31800::send_get_data(const map_ptr& map,
     const job::ptr& job) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    requesting_ = false;
+    exhausted_ = map->empty() && !announced_;
 
     if (stopped())
     {
@@ -230,19 +288,75 @@ void protocol_block_in_31800::send_get_data(const map_ptr& map,
         return;
     }
 
+    // Only an idle channel is starved (a pipelined request may find none).
     if (map->empty())
+    {
+        if (is_idle())
+            notify(error::success, chase::starved, events_key());
+
         return;
+    }
 
-    // There are two populated maps, return new and leave old in place.
-    if (!is_idle())
+    // The pipeline is full, return new and leave outstanding in place.
+    if (maps_.size() >= depth_)
     {
         restore(map);
         return;
     }
 
+    // Latency is timed from an idle channel, as otherwise the request queues
+    // behind outstanding blocks.
+    if (is_idle())
+        requested_at_ = steady_clock::now();
+
     job_ = job;
-    map_ = map;
-    SEND(create_get_data(*map_), handle_send, _1);
+    batch_ = map->size();
+    maps_.push_back(map);
+    SEND(create_get_data(*map), handle_send, _1);
+}
+
+// Request work unless a request is outstanding (one at a time), or the
+// channel has reached its limit of blocks pending archival (backpressure).
+// A draining channel that found no work does not request again until new
+// work is announced (chase::download), as each block would otherwise post
+// another request through the check strand.
+void protocol_block_in_31800::get_work() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (requesting_ || (exhausted_ && !is_idle()) ||
+        (!is_zero(archive_backlog_) && archiving_ >= archive_backlog_))
+        return;
+
+    requesting_ = true;
+    announced_ = false;
+    get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+}
+
+// The next batch is requested once the newest has drained by half, so that
+// the pipe remains full for the round trip of the next get_data.
+bool protocol_block_in_31800::is_draining() const NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    return maps_.size() < depth_ && maps_.back()->size() <= to_half(batch_);
+}
+
+size_t protocol_block_in_31800::outstanding() const NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    size_t count{};
+    for (const auto& map: maps_)
+        count += map->size();
+
+    return count;
+}
+
+void protocol_block_in_31800::restore_all() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    for (const auto& map: maps_)
+        restore(map);
+
+    maps_.clear();
 }
 
 get_data protocol_block_in_31800::create_get_data(
@@ -276,10 +390,14 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
 
     const auto& block = message->block_ptr;
     const auto& hash = block->get_hash();
-    const auto it = map_->find(hash);
-    auto& query = archive();
+    const auto batch = std::find_if(maps_.begin(), maps_.end(),
+        [&](const map_ptr& map) NOEXCEPT
+        {
+            return map->find(hash) != map->end();
+        });
 
-    if (it == map_->end())
+    auto& query = archive();
+    if (batch == maps_.end())
     {
         // Allow unrequested block, not counted toward performance.
         LOGR("Unrequested block [" << encode_hash(hash) << "] from ["
@@ -287,97 +405,127 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
         return true;
     }
 
+    // First requested block following an idle request, retained in history.
+    if (requested_at_ != steady_clock::time_point{})
+    {
+        const auto span = duration_cast<milliseconds>(steady_clock::now() -
+            requested_at_);
+        if (is_history_recorded())
+            get_history().set_latency(history_key(),
+                possible_narrow_sign_cast<uint32_t>(span.count()));
+
+        requested_at_ = {};
+    }
+
+    const auto map = *batch;
+    const auto it = map->find(hash);
     const auto link = it->link;
     const auto height = it->context.height;
 
-    // Check block.
+    // End-game requests a block from two channels, the first is archived.
+    // Only heights covered by end-game can have a copy, so others are not
+    // searched (hashmap search).
+    if (is_endgame(height) && query.is_associated(link))
+    {
+        LOGV("Redundant block [" << encode_hash(hash) << ":" << height
+            << "] from [" << opposite() << "].");
+        fire(events::endgame_redundant, height);
+        complete(map, hash);
+        return true;
+    }
+
+    // Archive block.
     // ........................................................................
 
     const auto checked = is_under_checkpoint(height);
     const auto bypass = checked || query.is_milestone(link);
 
-    // Tx commitments and malleation are checked under bypass. Invalidity is
-    // only stored when a strong header has been stored, later to be found out
-    // as invalid and not malleable. Stored invalidity prevents repeat
-    // processing of the same invalid chain but is not necessary or desirable.
-    if (const auto code = check(*block, it->context, bypass))
+    // Retain the association for restore should archival fail.
+    const auto work = chaser_check::empty_map();
+    work->insert(*it);
+
+    // Check and store are written behind, the channel continues reading.
+    // The job is bound so that a purge does not complete (and restart
+    // tracking) while its blocks are still being archived.
+    ++archiving_;
+    count(block->serialized_size(true));
+    write_block(block, link, it->context, checked, bypass,
+        BIND(handle_write_block, _1, block, work, job_));
+
+    complete(map, hash);
+    return true;
+}
+
+void protocol_block_in_31800::handle_write_block(const code& ec,
+    const chain::block::cptr& block, const map_ptr& work,
+    const job::ptr& job) NOEXCEPT
+{
+    POST(do_write_block, ec, block, work, job);
+}
+
+// The job reference is released here (or when the handler is dropped).
+void protocol_block_in_31800::do_write_block(const code& ec,
+    const chain::block::cptr& block, const map_ptr& work,
+    const job::ptr&) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    --archiving_;
+
+    const auto& item = *work->begin();
+    if (ec)
     {
-        if (code == system::error::invalid_transaction_commitment ||
-            code == system::error::invalid_witness_commitment)
+        restore(work);
+        if (stopped())
+            return;
+
+        if (ec == system::error::invalid_transaction_commitment ||
+            ec == system::error::invalid_witness_commitment)
         {
-            LOGR("Malleated block [" << encode_hash(hash) << ":" << height
-                << "] from [" << opposite() << "] " << code.message()
-                << " txs(" << block->transactions() << ")"
+            LOGR("Malleated block [" << encode_hash(item.hash) << ":"
+                << item.context.height << "] from [" << opposite() << "] "
+                << ec.message() << " txs(" << block->transactions() << ")"
                 << " segregated(" << block->is_segregated() << ").");
-            stop(code);
-            return false;
         }
-
-        if (!query.set_block_unconfirmable(link))
+        else
         {
-            stop(fault(error::protocol1));
-            return false;
+            LOGR("Block failed archival [" << encode_hash(item.hash) << ":"
+                << item.context.height << "] from [" << opposite() << "] "
+                << ec.message());
         }
 
-        LOGR("Block failed check [" << encode_hash(hash) << ":" << height
-            << "] from [" << opposite() << "] " << code.message());
-        notify(error::success, chase::unchecked, link);
-        fire(events::block_unconfirmable, height);
-        stop(code);
-        return false;
+        stop(ec);
+        return;
     }
 
-    // Commit block.txs.
-    // ........................................................................
-
-    if (const auto code = query.set_code(*block, link, checked, bypass, height))
-    {
-        LOGF("Failure storing block [" << encode_hash(hash) << ":" << height
-            << "] from [" << opposite() << "] " << code.message());
-
-        stop(fault(code));
-        return false;
-    }
+    LOGP("Downloaded block [" << encode_hash(item.hash) << ":"
+        << item.context.height << "] from [" << opposite() << "].");
 
-    // Advance.
-    // ........................................................................
+    if (stopped())
+        return;
 
-    LOGP("Downloaded block [" << encode_hash(hash) << ":" << height
-        << "] from [" << opposite() << "].");
+    // Resume work requests deferred by the archival backlog.
+    if (is_idle() || is_draining())
+        get_work();
+}
 
-    notify(ec, chase::checked, height);
-    fire(events::block_archived, height);
+// Remove block from its batch, get more work when idle or draining.
+void protocol_block_in_31800::complete(const map_ptr& map,
+    const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    map->erase(hash);
+    if (map->empty())
+        std::erase(maps_, map);
 
-    count(block->serialized_size(true));
-    map_->erase(it);
     if (is_idle())
     {
         job_.reset();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+        get_work();
     }
-
-    return true;
-}
-
-// Identity is correct unless error::invalid_witness_commitment or
-// error::invalid_transaction_commitment is returned. Only identity is required
-// under bypass. Header state is checked by organize. 
-code protocol_block_in_31800::check(const chain::block& block,
-    const chain::context& ctx, bool bypass) const NOEXCEPT
-{
-    code ec{};
-    if (bypass)
+    else if (is_draining())
     {
-        if (((ec = block.identify())) || ((ec = block.identify(ctx))))
-            return ec;
+        get_work();
     }
-    else
-    {
-        if (((ec = block.check())) || ((ec = block.check(ctx))))
-            return ec;
-    }
-
-    return error::success;
 }
 
 // get/put hashes
@@ -418,12 +566,7 @@ void protocol_block_in_31800::handle_get_hashes(const code& ec,
         return;
     }
 
-    if (map->empty())
-    {
-        notify(error::success, chase::starved, events_key());
-        return;
-    }
-
+    // Empty map is handled on strand, as starvation depends on idleness.
     POST(send_get_data, map, job);
 }
 
@@ -18,6 +18,8 @@
  */
 #include <bitcoin/node/protocols/protocol_peer.hpp>
 
+#include <sstream>
+#include <string>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -43,7 +45,8 @@ void protocol_peer::organize(const system::chain::block::cptr& block,
 
 void protocol_peer::get_hashes(map_handler&& handler) NOEXCEPT
 {
-    session_->get_hashes(std::move(handler));
+    // Channel identifies the requester for frontier work assignment.
+    session_->get_hashes(events_key(), std::move(handler));
 }
 
 void protocol_peer::put_hashes(const map_ptr& map,
@@ -52,6 +55,14 @@ void protocol_peer::put_hashes(const map_ptr& map,
     session_->put_hashes(map, std::move(handler));
 }
 
+void protocol_peer::write_block(const system::chain::block::cptr& block,
+    const database::header_link& link, const system::chain::context& ctx,
+    bool checked, bool bypass, network::result_handler&& handler) NOEXCEPT
+{
+    session_->write_block(block, link, ctx, checked, bypass,
+        std::move(handler));
+}
+
 // Methods.
 // ----------------------------------------------------------------------------
 
@@ -62,6 +73,35 @@ void protocol_peer::performance(uint64_t speed,
     session_->performance(events_key(), speed, std::move(handler));
 }
 
+void protocol_peer::prior_performance(uint64_t speed) const NOEXCEPT
+{
+    session_->prior_performance(events_key(), speed);
+}
+
+peer_history& protocol_peer::get_history() const NOEXCEPT
+{
+    return session_->get_history();
+}
+
+bool protocol_peer::is_history_recorded() const NOEXCEPT
+{
+    return session_->is_history_recorded();
+}
+
+bool protocol_peer::is_endgame(size_t height) const NOEXCEPT
+{
+    return session_->is_endgame(height);
+}
+
+std::string protocol_peer::history_key() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    std::ostringstream key{};
+    key << opposite();
+    return key.str();
+    BC_POP_WARNING()
+}
+
 code protocol_peer::fault(const code& ec) NOEXCEPT
 {
     // Short-circuit self stop.
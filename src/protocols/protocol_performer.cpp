@@ -39,6 +39,15 @@ void protocol_performer::start_performance() NOEXCEPT
 
     if (enabled_)
     {
+        // Initial work is sized by the persisted rate of the peer, if any.
+        if (deviation_ && !prior_ && is_history_recorded())
+        {
+            prior_ = true;
+            const auto rate = get_history().rate(history_key());
+            if (!is_zero(rate))
+                prior_performance(rate);
+        }
+
         bytes_ = zero;
         start_ = steady_clock::now();
         performance_timer_->start(BIND(handle_performance_timer, _1));
@@ -71,8 +80,14 @@ void protocol_performer::handle_performance_timer(const code& ec) NOEXCEPT
     }
 
     // Submit performance to (outbound session) aggregate monitor in bytes/sec.
-    send_performance(floored_divide(bytes_, greater(sign_cast<uint64_t>(
-        duration_cast<seconds>(steady_clock::now() - start_).count()), one)));
+    const auto rate = floored_divide(bytes_, greater(sign_cast<uint64_t>(
+        duration_cast<seconds>(steady_clock::now() - start_).count()), one));
+
+    // Retained across restarts, a stalled (zero) rate is not recorded.
+    if (is_history_recorded())
+        get_history().set_rate(history_key(), rate);
+
+    send_performance(rate);
 }
 
 void protocol_performer::pause_performance() NOEXCEPT
@@ -52,9 +52,9 @@ void session::organize(const block::cptr& block,
     node_.organize(block, std::move(handler));
 }
 
-void session::get_hashes(map_handler&& handler) NOEXCEPT
+void session::get_hashes(object_key channel, map_handler&& handler) NOEXCEPT
 {
-    node_.get_hashes(std::move(handler));
+    node_.get_hashes(channel, std::move(handler));
 }
 
 void session::put_hashes(const map_ptr& map,
@@ -63,6 +63,13 @@ void session::put_hashes(const map_ptr& map,
     node_.put_hashes(map, std::move(handler));
 }
 
+void session::write_block(const system::chain::block::cptr& block,
+    const database::header_link& link, const system::chain::context& ctx,
+    bool checked, bool bypass, network::result_handler&& handler) NOEXCEPT
+{
+    node_.write_block(block, link, ctx, checked, bypass, std::move(handler));
+}
+
 // Events.
 // ----------------------------------------------------------------------------
 
@@ -97,10 +104,47 @@ void session::unsubscribe_events(object_key key) NOEXCEPT
 // Methods.
 // ----------------------------------------------------------------------------
 
+bool session::is_inbound() const NOEXCEPT
+{
+    return false;
+}
+
 void session::performance(object_key key, uint64_t speed,
     result_handler&& handler) NOEXCEPT
 {
-    node_.performance(key, speed, std::move(handler));
+    node_.performance(key, speed, is_inbound(), std::move(handler));
+}
+
+void session::prior_performance(object_key key, uint64_t speed) NOEXCEPT
+{
+    node_.prior_performance(key, speed);
+}
+
+peer_history& session::get_history() const NOEXCEPT
+{
+    return node_.get_history();
+}
+
+// Inbound peers are keyed by ephemeral source ports (not dialable) and
+// manual peers are dialed regardless, so base sessions are not recorded.
+bool session::is_history_recorded() const NOEXCEPT
+{
+    return false;
+}
+
+bool session::admit_outbound() const NOEXCEPT
+{
+    return node_.admit_outbound();
+}
+
+void session::outbound_connected() const NOEXCEPT
+{
+    node_.outbound_connected();
+}
+
+bool session::is_endgame(size_t height) const NOEXCEPT
+{
+    return node_.is_endgame(height);
 }
 
 network::memory& session::get_memory() const NOEXCEPT
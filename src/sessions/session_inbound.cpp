@@ -21,6 +21,11 @@
 namespace libbitcoin {
 namespace node {
 
+bool session_inbound::is_inbound() const NOEXCEPT
+{
+    return true;
+}
+
 // Inbound connection attempts are dropped unless confirmed chain is current.
 // Used instead of suspension because suspension has independent start/stop.
 bool session_inbound::enabled() const NOEXCEPT
@@ -18,8 +18,72 @@
  */
 #include <bitcoin/node/sessions/session_outbound.hpp>
 
+#include <string>
+#include <utility>
+#include <bitcoin/node/define.hpp>
+
 namespace libbitcoin {
 namespace node {
 
+using namespace network;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+bool session_outbound::is_history_recorded() const NOEXCEPT
+{
+    return true;
+}
+
+// Preferred peers are queued once (at node start), so this only reorders the
+// first connection attempts. A failed preferred connection is not retried and
+// a preferred peer may also be taken again from the address pool.
+void session_outbound::take(address_item_handler&& handler) const NOEXCEPT
+{
+    // Above the adaptive outbound target (counting pending attempts) the
+    // connection attempt fails and is retried by the base session after its
+    // retry timeout.
+    if (!admit_outbound())
+    {
+        handler(network::error::address_not_found, {});
+        return;
+    }
+
+    std::string peer{};
+    while (get_history().next(peer))
+    {
+        if (const auto address = to_address(peer))
+        {
+            handler(error::success, address);
+            return;
+        }
+    }
+
+    base::take(std::move(handler));
+}
+
+// Releases the pending admission of the (winning) connection attempt.
+session_outbound::channel_ptr session_outbound::create_channel(
+    const socket_ptr& socket) NOEXCEPT
+{
+    outbound_connected();
+    return base::create_channel(socket);
+}
+
+// private
+// A history key that does not parse as an address is skipped (null).
+address_item_cptr session_outbound::to_address(const std::string& peer) NOEXCEPT
+{
+    try
+    {
+        return config::address{ peer }.item_ptr();
+    }
+    catch (...)
+    {
+        return {};
+    }
+}
+
+BC_POP_WARNING()
+
 } // namespace node
 } // namespace libbitcoin
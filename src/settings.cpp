@@ -34,19 +34,35 @@ settings::settings() NOEXCEPT
     memory_priority{ true },
     thread_priority{ true },
     allow_overlapped{ true },
+    allocation_adaptive{ false },
+    allocation_huge_pages{ false },
+    allocation_numa{ false },
     defer_validation{ false },
     defer_confirmation{ false },
+    robust_deviation{ false },
+    rebalance_work{ false },
     minimum_fee_rate{ 0.0 },
     minimum_bump_rate{ 0.0 },
     allowed_deviation{ 1.5 },
     announcement_cache{ 42 },
     allocation_multiple{ 20 },
+    pipeline_depth{ 2 },
+    history_preferred{ 8 },
+    current_outbound{ 0 },
+    archive_backlog{ 32 },
+    prefetch_blocks{ 16 },
+    allocation_retain_bytes{ 0 },
+    maximum_window_bytes{ 8'000'000'000 },
     ////snapshot_bytes{ 200'000'000'000 },
     ////snapshot_valid{ 250'000 },
     ////snapshot_confirm{ 500'000 },
     maximum_height{ 0 },
     maximum_concurrency{ 50'000 },
+    history_capacity{ 1'000 },
+    parallel_connect{ 500 },
+    archive_threads{ 4 },
     sample_period_seconds{ 10 },
+    endgame_seconds{ 5 },
     currency_window_minutes{ 1440 },
     threads{ 1 }
 {
@@ -73,11 +89,21 @@ size_t settings::maximum_concurrency_() const NOEXCEPT
     return to_bool(maximum_concurrency) ? maximum_concurrency : max_size_t;
 }
 
+uint64_t settings::maximum_window_bytes_() const NOEXCEPT
+{
+    return to_bool(maximum_window_bytes) ? maximum_window_bytes : max_uint64;
+}
+
 network::steady_clock::duration settings::sample_period() const NOEXCEPT
 {
     return network::seconds(sample_period_seconds);
 }
 
+network::steady_clock::duration settings::endgame_period() const NOEXCEPT
+{
+    return network::seconds(endgame_seconds);
+}
+
 network::wall_clock::duration settings::currency_window() const NOEXCEPT
 {
     return network::minutes(currency_window_minutes);
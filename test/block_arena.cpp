@@ -82,6 +82,11 @@ public:
         size_ = size;
     }
 
+    chunk_pool* get_pool() NOEXCEPT
+    {
+        return pool_.get();
+    }
+
     void release(void* address) NOEXCEPT override
     {
         block_arena::release(address);
@@ -632,6 +637,358 @@ BOOST_AUTO_TEST_CASE(block_arena__do_allocate__do_deallocate__expected)
     BOOST_REQUIRE_EQUAL(instance.deallocated_offset, offset);
 }
 
+// pool
+
+constexpr auto prefix_size = alignof(std::max_align_t);
+
+BOOST_AUTO_TEST_CASE(block_arena__pool__no_retain__nullptr)
+{
+    accessor instance{ 10 };
+    BOOST_REQUIRE(is_null(instance.pool()));
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__pool__retain__expected_limit)
+{
+    accessor instance{ 10, 100'000 };
+    BOOST_REQUIRE(!is_null(instance.pool()));
+    BOOST_REQUIRE_EQUAL(instance.pool()->limit(), 100'000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__retain__class_size_prefixed_allocation)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 100'000 };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().size(), 4096u + prefix_size);
+    BOOST_REQUIRE_EQUAL(std::next(instance.stack.front().data(), prefix_size), memory);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), 4096u);
+    BOOST_REQUIRE_EQUAL(instance.capacity_(), 4096u - link_size);
+    BOOST_REQUIRE_EQUAL(instance.pool()->misses(), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__retain__reused_not_freed)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 100'000 };
+    const auto memory1 = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size);
+    instance.release(memory1);
+    BOOST_REQUIRE(instance.freed.empty());
+    BOOST_REQUIRE_EQUAL(instance.pool()->retained(), 4096u);
+
+    // Second start reuses the released chunk without malloc.
+    const auto memory2 = instance.start(size);
+    BOOST_REQUIRE_EQUAL(memory2, memory1);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.pool()->hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.pool()->retained(), zero);
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size);
+
+    // Retained chunks are not freed by mock, must drain before destruct.
+    instance.release(memory2);
+    BOOST_REQUIRE(!is_null(instance.get_pool()->drain()));
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__retain_exceeded__freed_prefixed)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 1'000 };
+    const auto memory = instance.start(size);
+    instance.release(memory);
+    BOOST_REQUIRE_EQUAL(instance.freed.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.freed.front(), instance.stack.front().data());
+    BOOST_REQUIRE_EQUAL(instance.pool()->retained(), zero);
+}
+
+// huge pages
+
+#if !defined(HAVE_MSC)
+constexpr auto huge_page_size = 2u * 1024u * 1024u;
+
+BOOST_AUTO_TEST_CASE(block_arena__start__huge_pages_small__malloc_allocation)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, zero, true };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().data(), memory);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().size(), size * multiple);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), size * multiple);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__huge_pages_retain_small__class_allocation)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 10'000'000, true };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(std::next(instance.stack.front().data(), prefix_size), memory);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().size(), chunk_pool::to_class(size * multiple) + prefix_size);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), chunk_pool::to_class(size * multiple));
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__huge_pages__page_filling_allocation)
+{
+    constexpr auto size = 1'000'000u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, zero, true };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().data(), memory);
+
+    // Mock malloc_ bypasses mapping, the mapping prefix is in map_pages.
+    BOOST_REQUIRE_EQUAL(instance.stack.front().size(), huge_page_size - prefix_size);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), huge_page_size - prefix_size);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__huge_pages_retain__page_filling_allocation)
+{
+    constexpr auto size = 1'000'000u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 10'000'000, true };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.stack.size(), one);
+    BOOST_REQUIRE_EQUAL(std::next(instance.stack.front().data(), prefix_size), memory);
+    BOOST_REQUIRE_EQUAL(instance.stack.front().size(), huge_page_size - prefix_size);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), huge_page_size - two * prefix_size);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__huge_pages_retain__retained_by_class)
+{
+    constexpr auto size = 1'000'000u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, 10'000'000, true };
+    const auto memory1 = instance.start(size);
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size);
+    instance.release(memory1);
+    BOOST_REQUIRE(instance.freed.empty());
+
+    // Mapped chunks are retained under their (class) mapped length.
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(huge_page_size), huge_page_size);
+    BOOST_REQUIRE_EQUAL(instance.pool()->retained(), huge_page_size);
+
+    const auto memory2 = instance.start(size);
+    BOOST_REQUIRE_EQUAL(memory2, memory1);
+    BOOST_REQUIRE_EQUAL(instance.pool()->hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size);
+    instance.release(memory2);
+    BOOST_REQUIRE(!is_null(instance.get_pool()->drain()));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(block_arena__release__huge_pages__allocates_and_releases)
+{
+    constexpr auto size = 1000u;
+    constexpr auto multiple = 2u;
+    block_arena instance{ multiple, zero, true };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE(!is_null(memory));
+
+    // Allocation exceeding the (page filling) chunk links another chunk.
+    const auto first = pointer_cast<uint8_t>(instance.allocate(100, 8));
+    const auto second = pointer_cast<uint8_t>(instance.allocate(3'000'000, 8));
+    BOOST_REQUIRE(!is_null(first));
+    BOOST_REQUIRE(!is_null(second));
+    first[99] = 0x42;
+    second[2'999'999] = 0x42;
+    BOOST_REQUIRE_GT(instance.detach(), 3'000'100u);
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+}
+
+// numa
+
+BOOST_AUTO_TEST_CASE(block_arena__mapped__no_nodes__zero)
+{
+    accessor instance{ 10 };
+    BOOST_REQUIRE_EQUAL(instance.mapped(0), zero);
+    BOOST_REQUIRE_EQUAL(instance.mapped(1), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__nodes__allocates_and_releases)
+{
+    constexpr auto size = 1000u;
+    constexpr auto multiple = 2u;
+    constexpr auto nodes = 2u;
+    block_arena instance{ multiple, zero, false, nodes };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE(!is_null(memory));
+
+    const auto first = pointer_cast<uint8_t>(instance.allocate(100, 8));
+    const auto second = pointer_cast<uint8_t>(instance.allocate(3'000, 8));
+    BOOST_REQUIRE(!is_null(first));
+    BOOST_REQUIRE(!is_null(second));
+    first[99] = 0x42;
+    second[2'999] = 0x42;
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+
+    // Node binding is a nop without HAVE_NUMA, and beyond range is zero.
+    BOOST_REQUIRE_EQUAL(instance.mapped(nodes), zero);
+}
+
+// adaptive
+
+BOOST_AUTO_TEST_CASE(block_arena__learned_multiple__not_adaptive__unchanged_counted)
+{
+    constexpr auto size = 100u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple };
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 2.0);
+
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_NO_THROW(instance.allocate(300, 1));
+    BOOST_REQUIRE_EQUAL(instance.detach(), 2u * link_size + 300u);
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 2.0);
+    BOOST_REQUIRE_EQUAL(instance.blocks(), one);
+    BOOST_REQUIRE_EQUAL(instance.chained(), one);
+
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_EQUAL(instance.get_size(), multiple * size);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__adaptive__learned_size)
+{
+    constexpr auto size = 100u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, zero, false, zero, true };
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_EQUAL(instance.get_size(), multiple * size);
+
+    // Total of 316 bytes is a ratio of 51/16 (rounded up).
+    BOOST_REQUIRE_NO_THROW(instance.allocate(300, 1));
+    BOOST_REQUIRE_EQUAL(instance.detach(), 2u * link_size + 300u);
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 51.0 / 16.0);
+    BOOST_REQUIRE_EQUAL(instance.chained(), one);
+
+    // Next block starts with the learned size (rounded up), without chaining.
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_EQUAL(instance.get_size(), 319u);
+    BOOST_REQUIRE_NO_THROW(instance.allocate(300, 1));
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size + 300u);
+    BOOST_REQUIRE_EQUAL(instance.blocks(), two);
+    BOOST_REQUIRE_EQUAL(instance.chained(), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__adaptive_outlier__percentile_size)
+{
+    constexpr auto size = 100u;
+    constexpr auto multiple = 4u;
+    accessor instance{ multiple, zero, false, zero, true };
+
+    // Blocks of 250 bytes are a ratio of 40/16.
+    for (auto block = 0; block < 20; ++block)
+    {
+        BOOST_REQUIRE_NO_THROW(instance.start(size));
+        BOOST_REQUIRE_NO_THROW(instance.allocate(250 - link_size, 1));
+        BOOST_REQUIRE_EQUAL(instance.detach(), 250u);
+    }
+
+    // A single outlier is above the percentile of 21 samples.
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_NO_THROW(instance.allocate(1'000, 1));
+    BOOST_REQUIRE_NO_THROW(instance.detach());
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 40.0 / 16.0);
+
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_EQUAL(instance.get_size(), 250u);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__adaptive_small_blocks__at_least_wire_size)
+{
+    constexpr auto size = 100u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple, zero, false, zero, true };
+
+    // Empty blocks are a ratio of 2/16 (link size only), learned as one.
+    for (auto block = 0; block < 20; ++block)
+    {
+        BOOST_REQUIRE_NO_THROW(instance.start(size));
+        BOOST_REQUIRE_EQUAL(instance.detach(), link_size);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 1.0);
+    BOOST_REQUIRE_NO_THROW(instance.start(size));
+    BOOST_REQUIRE_EQUAL(instance.get_size(), size);
+}
+
+// telemetry
+
+BOOST_AUTO_TEST_CASE(block_arena__detach__started__in_flight_until_released)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_NO_THROW(instance.allocate(3, 1));
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size + 3u);
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), link_size + 3u);
+    BOOST_REQUIRE_EQUAL(instance.largest(), link_size + 3u);
+    BOOST_REQUIRE_EQUAL(instance.detached(), one);
+    BOOST_REQUIRE_EQUAL(instance.released(), zero);
+
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+    BOOST_REQUIRE_EQUAL(instance.freed.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), zero);
+    BOOST_REQUIRE_EQUAL(instance.largest(), link_size + 3u);
+    BOOST_REQUIRE_EQUAL(instance.released(), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__undetached__unaccounted)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple };
+    const auto memory = instance.start(size);
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), zero);
+    BOOST_REQUIRE_EQUAL(instance.detached(), zero);
+    BOOST_REQUIRE_EQUAL(instance.released(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__detach__unaligned_allocations__padding)
+{
+    constexpr auto size = 20u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple };
+    const auto memory = instance.start(size);
+
+    // One byte at link_size, then eight aligned (padded to next eight).
+    BOOST_REQUIRE_NO_THROW(instance.allocate(1, 1));
+    BOOST_REQUIRE_NO_THROW(instance.allocate(8, 8));
+    BOOST_REQUIRE_EQUAL(instance.padding(), zero);
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size + 16u);
+    BOOST_REQUIRE_EQUAL(instance.padding(), 7u);
+    BOOST_REQUIRE_NO_THROW(instance.release(memory));
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__release__chained_blocks__in_flight_zero)
+{
+    constexpr auto size = 9u;
+    constexpr auto multiple = 2u;
+    accessor instance{ multiple };
+    const auto memory1 = instance.start(size);
+    BOOST_REQUIRE_NO_THROW(instance.allocate(100, 1));
+    const auto total1 = instance.detach();
+    const auto memory2 = instance.start(size);
+    const auto total2 = instance.detach();
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), total1 + total2);
+    BOOST_REQUIRE_EQUAL(instance.largest(), total1);
+
+    BOOST_REQUIRE_NO_THROW(instance.release(memory1));
+    BOOST_REQUIRE_EQUAL(instance.freed.size(), two);
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), total2);
+    BOOST_REQUIRE_NO_THROW(instance.release(memory2));
+    BOOST_REQUIRE_EQUAL(instance.freed.size(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), zero);
+    BOOST_REQUIRE_EQUAL(instance.released(), two);
+}
+
 // do_is_equal
 
 BOOST_AUTO_TEST_CASE(block_arena__do_is_equal__equal__true)
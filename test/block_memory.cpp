@@ -35,12 +35,17 @@ public:
 
     size_t get_size() const NOEXCEPT
     {
-        return arenas_.size();
+        return registry_->arenas.size();
     }
 
     arena* get_arena_at(size_t index) NOEXCEPT
     {
-        return &arenas_.at(index);
+        return &registry_->arenas.at(index);
+    }
+
+    block_arena* obtain_() NOEXCEPT
+    {
+        return obtain();
     }
 };
 
@@ -52,6 +57,8 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple_no_threads__default_ar
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), one);
 }
 
 BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_threads__default_arena)
@@ -62,6 +69,8 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_threads__default_arena)
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), one);
 }
 
 BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple__default_arena)
@@ -72,6 +81,8 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple__default_arena)
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), one);
 }
 
 BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_one_thread__not_default_arena)
@@ -84,19 +95,35 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_one_thread__not_default_a
     BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_threads__count_unincremented)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_threads__count_incremented_once)
 {
     constexpr size_t multiple = 42;
     constexpr size_t threads = 2;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), two);
 
-    // On any given thread count must not change.
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
+    // On any given thread count is incremented only upon first call.
     BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    const auto arena = instance.get_arena();
+    BOOST_REQUIRE_NE(arena, default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_count(), one);
+    BOOST_REQUIRE_EQUAL(instance.get_arena(), arena);
+    BOOST_REQUIRE_EQUAL(instance.get_count(), one);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_instances__independent_arenas)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 1;
+    accessor instance1{ multiple, threads };
+    accessor instance2{ multiple, threads };
+
+    // The same thread obtains an arena from each instance.
+    BOOST_REQUIRE_EQUAL(instance1.get_arena(), instance1.get_arena_at(0));
+    BOOST_REQUIRE_EQUAL(instance2.get_arena(), instance2.get_arena_at(0));
+    BOOST_REQUIRE_EQUAL(instance1.get_count(), one);
+    BOOST_REQUIRE_EQUAL(instance2.get_count(), one);
 }
 
 BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_threads__independent_not_default_arenas)
@@ -132,7 +159,7 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_threads__independent_not_defau
     BOOST_REQUIRE_NE(count1, count2);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__created_arena)
 {
     constexpr size_t multiple = 42;
     constexpr size_t threads = 2;
@@ -180,8 +207,11 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
     BOOST_REQUIRE_EQUAL(arena2, instance.get_arena_at(1));
     BOOST_REQUIRE_NE(arena1, arena2);
 
-    // Index overflows to default arena.
-    BOOST_REQUIRE_EQUAL(arena3, default_arena::get());
+    // Overflow creates an arena.
+    BOOST_REQUIRE_NE(arena3, default_arena::get());
+    BOOST_REQUIRE_EQUAL(arena3, instance.get_arena_at(2));
+    BOOST_REQUIRE_EQUAL(instance.arenas(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), zero);
 
     // Count reflects total, not the index of the thread.
     BOOST_REQUIRE_EQUAL(count1a, 0u);
@@ -192,4 +222,146 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
     BOOST_REQUIRE_EQUAL(count3b, 3u);
 }
 
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__exited_thread__arena_reused)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 1;
+    accessor instance{ multiple, threads };
+    void* arena1{};
+    void* arena2{};
+
+    // Thread exit returns its arena for use by the next thread.
+    std::thread thread1([&]() NOEXCEPT
+    {
+        arena1 = instance.get_arena();
+    });
+
+    thread1.join();
+
+    std::thread thread2([&]() NOEXCEPT
+    {
+        arena2 = instance.get_arena();
+    });
+
+    thread2.join();
+
+    BOOST_REQUIRE_NE(arena1, default_arena::get());
+    BOOST_REQUIRE_EQUAL(arena1, arena2);
+    BOOST_REQUIRE_EQUAL(instance.arenas(), one);
+    BOOST_REQUIRE_EQUAL(instance.get_count(), two);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__retained__no_retain__zeros)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 2;
+    accessor instance{ multiple, threads };
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+    BOOST_REQUIRE_EQUAL(instance.pool_hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.pool_misses(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__retained__retain__shared_among_arenas)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 2;
+    constexpr size_t retain = 100'000;
+    accessor instance{ multiple, threads, retain };
+    const auto arena = dynamic_cast<block_arena*>(instance.get_arena_at(0));
+    BOOST_REQUIRE(!is_null(arena));
+    BOOST_REQUIRE(!is_null(arena->pool()));
+    BOOST_REQUIRE_EQUAL(arena->pool()->limit(), retain);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__retained__arena_created_on_demand__within_retain)
+{
+    constexpr size_t multiple = 100;
+    constexpr size_t threads = 1;
+    constexpr size_t retain = 4096;
+    accessor instance{ multiple, threads, retain };
+
+    // The second arena is created on demand (as for an additional thread).
+    const auto arena1 = instance.obtain_();
+    const auto arena2 = instance.obtain_();
+    BOOST_REQUIRE_EQUAL(instance.arenas(), two);
+
+    const auto memory1 = arena1->start(20);
+    arena1->detach();
+    const auto memory2 = arena2->start(20);
+    arena2->detach();
+
+    // Both chunks are of the minimum class, only one fits the total retain.
+    arena1->release(memory1);
+    arena2->release(memory2);
+    BOOST_REQUIRE_EQUAL(instance.retained(), retain);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__learned_multiple__unstarted__configured_multiple)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 2;
+    accessor instance{ multiple, threads, zero, false, false, true };
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 42.0);
+    BOOST_REQUIRE_EQUAL(instance.chaining_rate(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__learned_multiple__adaptive__learned)
+{
+    constexpr size_t multiple = 2;
+    constexpr size_t threads = 1;
+    accessor instance{ multiple, threads, zero, false, false, true };
+    const auto arena = instance.get_arena();
+
+    // One chained chunk in one block, total of 316 bytes is 51/16 of wire.
+    const auto memory = arena->start(100);
+    BOOST_REQUIRE_NO_THROW(arena->allocate(300, 1));
+    BOOST_REQUIRE_EQUAL(arena->detach(), 2u * sizeof(void*) + 300u);
+    arena->release(memory);
+
+    BOOST_REQUIRE_EQUAL(instance.learned_multiple(), 51.0 / 16.0);
+    BOOST_REQUIRE_EQUAL(instance.chaining_rate(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__in_flight__detached_released__expected)
+{
+    constexpr size_t multiple = 2;
+    constexpr size_t threads = 1;
+    accessor instance{ multiple, threads };
+    const auto arena = instance.get_arena();
+
+    const auto memory = arena->start(100);
+    BOOST_REQUIRE_NO_THROW(arena->allocate(300, 1));
+    const auto total = arena->detach();
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), total);
+    BOOST_REQUIRE_EQUAL(instance.largest(), total);
+    BOOST_REQUIRE_EQUAL(instance.blocks(), one);
+    BOOST_REQUIRE_EQUAL(instance.chained(), one);
+    BOOST_REQUIRE_EQUAL(instance.detached(), one);
+    BOOST_REQUIRE_EQUAL(instance.released(), zero);
+
+    arena->release(memory);
+    BOOST_REQUIRE_EQUAL(instance.in_flight(), zero);
+    BOOST_REQUIRE_EQUAL(instance.released(), one);
+    BOOST_REQUIRE_EQUAL(instance.padding(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__nodes__no_numa__zero_empty)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 2;
+    accessor instance{ multiple, threads, zero, false, false };
+    BOOST_REQUIRE_EQUAL(instance.nodes(), zero);
+    BOOST_REQUIRE(instance.node_allocations().empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__nodes__numa__detected_nodes)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 2;
+    accessor instance{ multiple, threads, zero, false, true };
+    BOOST_REQUIRE_EQUAL(instance.nodes(), block_arena::numa_nodes());
+    BOOST_REQUIRE_EQUAL(instance.node_allocations().size(), instance.nodes());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,315 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+#include <chrono>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(block_prefetch_tests)
+
+// push/next
+
+BOOST_AUTO_TEST_CASE(block_prefetch__next__empty__false)
+{
+    block_prefetch instance{ 4 };
+    header_t link{};
+    BOOST_REQUIRE(!instance.next(link));
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__push__disabled__not_queued)
+{
+    block_prefetch instance{ 0 };
+    BOOST_REQUIRE(!instance.enabled());
+    instance.push(42, 42);
+    BOOST_REQUIRE_EQUAL(instance.queued(), zero);
+
+    header_t link{};
+    BOOST_REQUIRE(!instance.next(link));
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__next__queued__in_order_reserved)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 1u);
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 2u);
+    BOOST_REQUIRE(!instance.next(link));
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+    BOOST_REQUIRE_EQUAL(instance.queued(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__next__at_capacity__false_until_taken)
+{
+    block_prefetch instance{ 1 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(!instance.next(link));
+    BOOST_REQUIRE_EQUAL(instance.queued(), one);
+
+    instance.put(1, data_chunk{ 1 });
+    BOOST_REQUIRE(!instance.take(1).empty());
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__next__taken_before_dispatch__skipped)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+    BOOST_REQUIRE(instance.take(1).empty());
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 2u);
+    BOOST_REQUIRE(!instance.next(link));
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__push__queued_or_reserved__ignored)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.push(1, 1);
+    BOOST_REQUIRE_EQUAL(instance.queued(), one);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.push(1, 1);
+    BOOST_REQUIRE_EQUAL(instance.queued(), zero);
+    BOOST_REQUIRE(!instance.next(link));
+}
+
+// begin
+
+BOOST_AUTO_TEST_CASE(block_prefetch__begin__reserved__true)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.begin(link));
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__begin__taken_before_read__false)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.take(42).empty());
+    BOOST_REQUIRE(!instance.begin(link));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+// put/take
+
+BOOST_AUTO_TEST_CASE(block_prefetch__take__read__data_hit_removed)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(link, data_chunk{ 1, 2, 3 });
+
+    const auto data = instance.take(42);
+    BOOST_REQUIRE_EQUAL(data, (data_chunk{ 1, 2, 3 }));
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.misses(), zero);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.hit_rate(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__take__pending__miss_put_ignored)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.take(42).empty());
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+
+    instance.put(42, data_chunk{ 1 });
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__take__reading__waits_for_read_hit)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.begin(link));
+
+    std::thread reader([&]() NOEXCEPT
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        instance.put(42, data_chunk{ 1, 2, 3 });
+    });
+
+    const auto data = instance.take(42);
+    reader.join();
+    BOOST_REQUIRE_EQUAL(data, (data_chunk{ 1, 2, 3 }));
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__take__reading_failed__miss)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.begin(link));
+
+    std::thread reader([&]() NOEXCEPT
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        instance.put(42, {});
+    });
+
+    BOOST_REQUIRE(instance.take(42).empty());
+    reader.join();
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__put__unreserved__ignored)
+{
+    block_prefetch instance{ 4 };
+    instance.put(42, data_chunk{ 1 });
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__put__empty__reservation_dropped)
+{
+    block_prefetch instance{ 4 };
+    instance.push(42, 42);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(42, {});
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__hit_rate__half__fifty)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(1, data_chunk{ 1 });
+    BOOST_REQUIRE(!instance.take(1).empty());
+    BOOST_REQUIRE(instance.take(2).empty());
+    BOOST_REQUIRE_EQUAL(instance.hit_rate(), 50u);
+}
+
+// post/evict
+
+BOOST_AUTO_TEST_CASE(block_prefetch__evict__not_posted_at_or_below__removed)
+{
+    block_prefetch instance{ 2 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+    instance.push(3, 3);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(1, data_chunk{ 1 });
+    BOOST_REQUIRE(!instance.next(link));
+
+    // Read (1), reserved (2) and queued (3) at or below height are evicted.
+    instance.evict(3);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.queued(), zero);
+    BOOST_REQUIRE(!instance.begin(2));
+    BOOST_REQUIRE(!instance.next(link));
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.misses(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__evict__above__retained)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.evict(1);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(block_prefetch__evict__posted__retained)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.post(2, 2);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(1, data_chunk{ 1 });
+
+    // A block read ahead is then posted, which retains it.
+    instance.post(1, 1);
+    instance.evict(2);
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+    BOOST_REQUIRE_EQUAL(instance.queued(), one);
+    BOOST_REQUIRE(!instance.take(1).empty());
+    BOOST_REQUIRE(instance.next(link));
+    BOOST_REQUIRE_EQUAL(link, 2u);
+}
+
+// clear
+
+BOOST_AUTO_TEST_CASE(block_prefetch__clear__queued_and_read__empty_uncounted)
+{
+    block_prefetch instance{ 4 };
+    instance.push(1, 1);
+    instance.push(2, 2);
+
+    header_t link{};
+    BOOST_REQUIRE(instance.next(link));
+    instance.put(1, data_chunk{ 1 });
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.queued(), zero);
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.misses(), zero);
+    BOOST_REQUIRE(!instance.next(link));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
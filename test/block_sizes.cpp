@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_sizes_tests)
+
+// estimate
+
+BOOST_AUTO_TEST_CASE(block_sizes__estimate__era_boundaries__era_averages)
+{
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(0), 250u);
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(200'000), 100'000u);
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(500'000), 1'050'000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__estimate__within_era__interpolated)
+{
+    // Increasing era.
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(225'000), 125'000u);
+
+    // Decreasing era.
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(525'000), 975'000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__estimate__beyond_last_era__last_average)
+{
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(900'000), 1'600'000u);
+    BOOST_REQUIRE_EQUAL(block_sizes::estimate(max_size_t), 1'600'000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__estimate__all_heights__nonzero)
+{
+    for (size_t height = 0; height < 1'000'000; height += 997)
+        BOOST_REQUIRE(!is_zero(block_sizes::estimate(height)));
+}
+
+// span
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__zero_limit__zero)
+{
+    BOOST_REQUIRE_EQUAL(block_sizes::span(0, max_uint64, 0), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__unlimited_bytes__limit)
+{
+    BOOST_REQUIRE_EQUAL(block_sizes::span(0, max_uint64, 50'000), 50'000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__zero_bytes__one)
+{
+    BOOST_REQUIRE_EQUAL(block_sizes::span(800'000, 0, 50'000), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__last_era__bytes_over_size)
+{
+    // Beyond the last era every block is estimated at 1.6MB.
+    BOOST_REQUIRE_EQUAL(block_sizes::span(900'000, 16'000'000, 50'000), 10u);
+    BOOST_REQUIRE_EQUAL(block_sizes::span(900'000, 16'999'999, 50'000), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__early_versus_late__more_early_blocks)
+{
+    constexpr uint64_t bytes = 1'000'000'000;
+    const auto early = block_sizes::span(150'000, bytes, 50'000);
+    const auto late = block_sizes::span(850'000, bytes, 50'000);
+    BOOST_REQUIRE_GT(early, late);
+    BOOST_REQUIRE_EQUAL(late, 588u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__unlimited_count_early__spans_eras)
+{
+    // Summed per era (not per block), so an unlimited count is not a walk.
+    BOOST_REQUIRE_EQUAL(block_sizes::span(0, 8'000'000'000, max_size_t),
+        237'204u);
+}
+
+BOOST_AUTO_TEST_CASE(block_sizes__span__segment_boundaries__expected)
+{
+    // Era [0, 100'000) rises from 250 to 1'000 bytes.
+    BOOST_REQUIRE_EQUAL(block_sizes::span(0, 250, 50'000), one);
+    BOOST_REQUIRE_EQUAL(block_sizes::span(0, 500, 50'000), two);
+    BOOST_REQUIRE_EQUAL(block_sizes::span(99'998, 2'000, 50'000), two);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
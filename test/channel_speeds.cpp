@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(channel_speeds_tests)
+
+constexpr auto tolerance = 0.000001;
+
+// set/get/erase
+
+BOOST_AUTO_TEST_CASE(channel_speeds__default__empty_zeros)
+{
+    const channel_speeds instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.mean(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.deviation(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.spread(), 0.0);
+
+    object_key slowest{};
+    BOOST_REQUIRE(!instance.slowest(slowest));
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__set__replace__replaced)
+{
+    channel_speeds instance{};
+    instance.set(1, 10.0);
+    instance.set(1, 30.0);
+
+    double speed{};
+    BOOST_REQUIRE(instance.get(speed, 1));
+    BOOST_REQUIRE_EQUAL(speed, 30.0);
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+    BOOST_REQUIRE_CLOSE(instance.mean(), 30.0, tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__erase__missing_and_present__expected)
+{
+    channel_speeds instance{};
+    instance.set(1, 10.0);
+    BOOST_REQUIRE(!instance.erase(2));
+    BOOST_REQUIRE(instance.erase(1));
+    BOOST_REQUIRE(!instance.erase(1));
+
+    double speed{};
+    BOOST_REQUIRE(!instance.get(speed, 1));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.mean(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__slowest__multiple__lowest_speed)
+{
+    channel_speeds instance{};
+    instance.set(1, 20.0);
+    instance.set(2, 5.0);
+    instance.set(3, 40.0);
+
+    object_key slowest{};
+    BOOST_REQUIRE(instance.slowest(slowest));
+    BOOST_REQUIRE_EQUAL(slowest, 2u);
+
+    instance.set(2, 50.0);
+    BOOST_REQUIRE(instance.slowest(slowest));
+    BOOST_REQUIRE_EQUAL(slowest, 1u);
+}
+
+// mean/deviation
+
+BOOST_AUTO_TEST_CASE(channel_speeds__deviation__set_replace_erase__matches_batch)
+{
+    channel_speeds instance{};
+    instance.set(1, 2.0);
+    instance.set(2, 4.0);
+    instance.set(3, 4.0);
+    instance.set(4, 100.0);
+    instance.set(5, 5.0);
+    instance.set(4, 4.0);
+    instance.set(6, 7.0);
+    instance.set(7, 9.0);
+    instance.set(8, 1000.0);
+    BOOST_REQUIRE(instance.erase(8));
+
+    // { 2, 4, 4, 4, 5, 7, 9 }: mean 5, sample variance 32/6.
+    BOOST_REQUIRE_EQUAL(instance.size(), 7u);
+    BOOST_REQUIRE_CLOSE(instance.sum(), 35.0, tolerance);
+    BOOST_REQUIRE_CLOSE(instance.mean(), 5.0, tolerance);
+    BOOST_REQUIRE_CLOSE(instance.deviation(), std::sqrt(32.0 / 6.0), tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__deviation__one__zero)
+{
+    channel_speeds instance{};
+    instance.set(1, 42.0);
+    BOOST_REQUIRE_EQUAL(instance.deviation(), 0.0);
+}
+
+// median/spread
+
+BOOST_AUTO_TEST_CASE(channel_speeds__median__odd_and_even__middle)
+{
+    channel_speeds instance{};
+    instance.set(1, 3.0);
+    instance.set(2, 1.0);
+    instance.set(3, 2.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 2.0);
+
+    instance.set(4, 10.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__median__replace_and_erase__middle)
+{
+    channel_speeds instance{};
+    instance.set(1, 5.0);
+    instance.set(2, 1.0);
+    instance.set(3, 9.0);
+    instance.set(4, 3.0);
+    instance.set(5, 7.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 5.0);
+
+    // { 1, 3, 7, 9 }
+    BOOST_REQUIRE(instance.erase(1));
+    BOOST_REQUIRE_EQUAL(instance.median(), 5.0);
+
+    // { 3, 7, 8, 9 }
+    instance.set(2, 8.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 7.5);
+
+    // { 3, 8, 9 }
+    BOOST_REQUIRE(instance.erase(5));
+    BOOST_REQUIRE_EQUAL(instance.median(), 8.0);
+
+    // { 8, 9 }, { 9 }, {}
+    BOOST_REQUIRE(instance.erase(4));
+    BOOST_REQUIRE_EQUAL(instance.median(), 8.5);
+    BOOST_REQUIRE(instance.erase(2));
+    BOOST_REQUIRE_EQUAL(instance.median(), 9.0);
+    BOOST_REQUIRE(instance.erase(3));
+    BOOST_REQUIRE_EQUAL(instance.median(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__deviation__many_replacements__matches_batch)
+{
+    channel_speeds instance{};
+    for (size_t index = 0; index < 10'000; ++index)
+        instance.set(index % 4, 1'000'000.0 + (index % 7) * 0.1);
+
+    // Last set is index 9996..9999: { 0.0, 0.1, 0.2, 0.3 } above 1e6.
+    BOOST_REQUIRE_CLOSE(instance.mean(), 1'000'000.15, tolerance);
+    BOOST_REQUIRE_CLOSE(instance.deviation(), std::sqrt(0.05 / 3.0), 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__spread__fast_outlier__unaffected)
+{
+    channel_speeds instance{};
+    instance.set(1, 10.0);
+    instance.set(2, 11.0);
+    instance.set(3, 12.0);
+    instance.set(4, 13.0);
+    instance.set(5, 14.0);
+    const auto spread = instance.spread();
+    const auto median = instance.median();
+
+    // Deviations from 12 are { 2, 1, 0, 1, 2 }, median 1.
+    BOOST_REQUIRE_EQUAL(median, 12.0);
+    BOOST_REQUIRE_CLOSE(spread, 1.4826, tolerance);
+
+    // A fast outlier moves the mean well above average channels.
+    instance.set(6, 1000.0);
+    BOOST_REQUIRE_GT(instance.mean(), 100.0);
+    BOOST_REQUIRE_LE(instance.median(), 13.0);
+    BOOST_REQUIRE_LE(instance.spread(), 2.0 * 1.4826);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+#include <atomic>
+#include <memory>
+
+BOOST_AUTO_TEST_SUITE(chunk_pool_tests)
+
+// to_class
+
+BOOST_AUTO_TEST_CASE(chunk_pool__to_class__below_minimum__minimum)
+{
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(0), 4096u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(1), 4096u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(4096), 4096u);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__to_class__quarter_powers__expected)
+{
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(4097), 5120u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(5120), 5120u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(5121), 6144u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(7169), 8192u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(8192), 8192u);
+    BOOST_REQUIRE_EQUAL(chunk_pool::to_class(8193), 10240u);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__to_class__always__idempotent)
+{
+    for (auto bytes = 4000u; bytes < 40000u; bytes += 333u)
+    {
+        const auto size = chunk_pool::to_class(bytes);
+        BOOST_REQUIRE_GE(size, bytes);
+        BOOST_REQUIRE_EQUAL(chunk_pool::to_class(size), size);
+    }
+}
+
+// pop/push
+
+BOOST_AUTO_TEST_CASE(chunk_pool__pop__empty__nullptr_miss)
+{
+    chunk_pool instance{ 100'000 };
+    BOOST_REQUIRE(is_null(instance.pop(4096)));
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__push__within_limit__retained_hit)
+{
+    chunk_pool instance{ 100'000 };
+    uint8_t chunk{};
+    BOOST_REQUIRE(instance.push(&chunk, 8192));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 8192u);
+
+    // Other size class misses.
+    BOOST_REQUIRE(is_null(instance.pop(4096)));
+    BOOST_REQUIRE_EQUAL(instance.pop(8192), &chunk);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__push__exceeds_limit__false)
+{
+    chunk_pool instance{ 10'000 };
+    uint8_t chunk1{};
+    uint8_t chunk2{};
+    BOOST_REQUIRE(instance.push(&chunk1, 8192));
+    BOOST_REQUIRE(!instance.push(&chunk2, 8192));
+    BOOST_REQUIRE_EQUAL(instance.retained(), 8192u);
+    BOOST_REQUIRE_EQUAL(instance.drain(), &chunk1);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__push__shared_total_exceeds_limit__false)
+{
+    const auto total = std::make_shared<std::atomic_size_t>();
+    chunk_pool instance1{ 10'000, total };
+    chunk_pool instance2{ 10'000, total };
+    uint8_t chunk1{};
+    uint8_t chunk2{};
+    BOOST_REQUIRE(instance1.push(&chunk1, 8192));
+    BOOST_REQUIRE(!instance2.push(&chunk2, 4096));
+    BOOST_REQUIRE_EQUAL(total->load(), 8192u);
+    BOOST_REQUIRE_EQUAL(instance1.drain(), &chunk1);
+    BOOST_REQUIRE_EQUAL(total->load(), zero);
+    BOOST_REQUIRE(instance2.push(&chunk2, 4096));
+    BOOST_REQUIRE_EQUAL(instance2.retained(), 4096u);
+    BOOST_REQUIRE_EQUAL(instance2.drain(), &chunk2);
+}
+
+BOOST_AUTO_TEST_CASE(chunk_pool__push__zero_limit__false)
+{
+    chunk_pool instance{ 0 };
+    uint8_t chunk{};
+    BOOST_REQUIRE(!instance.push(&chunk, 4096));
+    BOOST_REQUIRE_EQUAL(instance.limit(), zero);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+}
+
+// drain
+
+BOOST_AUTO_TEST_CASE(chunk_pool__drain__multiple_classes__all_uncounted)
+{
+    chunk_pool instance{ 100'000 };
+    uint8_t chunk1{};
+    uint8_t chunk2{};
+    BOOST_REQUIRE(instance.push(&chunk1, 4096));
+    BOOST_REQUIRE(instance.push(&chunk2, 8192));
+    BOOST_REQUIRE(!is_null(instance.drain()));
+    BOOST_REQUIRE(!is_null(instance.drain()));
+    BOOST_REQUIRE(is_null(instance.drain()));
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.misses(), zero);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(height_bitmap_tests)
+
+// is_set/set
+
+BOOST_AUTO_TEST_CASE(height_bitmap__is_set__default__false)
+{
+    const height_bitmap instance{};
+    BOOST_REQUIRE(!instance.is_set(0));
+    BOOST_REQUIRE(!instance.is_set(42));
+    BOOST_REQUIRE_EQUAL(instance.count(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__set__heights__is_set)
+{
+    height_bitmap instance{};
+    instance.set(100);
+    instance.set(63);
+    instance.set(300);
+    BOOST_REQUIRE(instance.is_set(63));
+    BOOST_REQUIRE(instance.is_set(100));
+    BOOST_REQUIRE(instance.is_set(300));
+    BOOST_REQUIRE(!instance.is_set(64));
+    BOOST_REQUIRE(!instance.is_set(299));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__set__range__inclusive)
+{
+    height_bitmap instance{};
+    instance.set(10, 200);
+    BOOST_REQUIRE(!instance.is_set(9));
+    BOOST_REQUIRE(instance.is_set(10));
+    BOOST_REQUIRE(instance.is_set(200));
+    BOOST_REQUIRE(!instance.is_set(201));
+    BOOST_REQUIRE_EQUAL(instance.count(), 191u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__reset__set__unset)
+{
+    height_bitmap instance{};
+    instance.set(5, 7);
+    instance.reset(6);
+    instance.reset(1000);
+    BOOST_REQUIRE(instance.is_set(5));
+    BOOST_REQUIRE(!instance.is_set(6));
+    BOOST_REQUIRE(instance.is_set(7));
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+}
+
+// next_unset
+
+BOOST_AUTO_TEST_CASE(height_bitmap__next_unset__empty__height)
+{
+    const height_bitmap instance{};
+    BOOST_REQUIRE_EQUAL(instance.next_unset(0), 0u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(1000), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__next_unset__run_across_words__end_of_run)
+{
+    height_bitmap instance{};
+    instance.set(1, 250);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(0), 0u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(1), 251u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(128), 251u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(251), 251u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(400), 400u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__next_unset__full_last_word__beyond_words)
+{
+    height_bitmap instance{};
+    instance.set(0, 127);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(0), 128u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(127), 128u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__next_unset__gap__gap)
+{
+    height_bitmap instance{};
+    instance.set(0, 200);
+    instance.reset(150);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(10), 150u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(151), 201u);
+}
+
+// reset_above
+
+BOOST_AUTO_TEST_CASE(height_bitmap__reset_above__partial_word__masked)
+{
+    height_bitmap instance{};
+    instance.set(0, 300);
+    instance.reset_above(100);
+    BOOST_REQUIRE(instance.is_set(100));
+    BOOST_REQUIRE(!instance.is_set(101));
+    BOOST_REQUIRE(!instance.is_set(300));
+    BOOST_REQUIRE_EQUAL(instance.count(), 101u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(0), 101u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__reset_above__word_boundary__dropped)
+{
+    height_bitmap instance{};
+    instance.set(0, 300);
+    instance.reset_above(127);
+    BOOST_REQUIRE(instance.is_set(127));
+    BOOST_REQUIRE(!instance.is_set(128));
+    BOOST_REQUIRE_EQUAL(instance.count(), 128u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__reset_above__below_floor__cleared)
+{
+    height_bitmap instance{};
+    instance.set(200, 300);
+    instance.trim(260);
+    instance.reset_above(10);
+    BOOST_REQUIRE_EQUAL(instance.count(), zero);
+    BOOST_REQUIRE(!instance.is_set(250));
+}
+
+// trim
+
+BOOST_AUTO_TEST_CASE(height_bitmap__trim__whole_words__discarded_below)
+{
+    height_bitmap instance{};
+    instance.set(0, 200);
+    instance.trim(130);
+    BOOST_REQUIRE(!instance.is_set(127));
+    BOOST_REQUIRE(instance.is_set(128));
+    BOOST_REQUIRE(instance.is_set(200));
+    BOOST_REQUIRE_EQUAL(instance.count(), 73u);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(130), 201u);
+}
+
+BOOST_AUTO_TEST_CASE(height_bitmap__trim__then_set_below_floor__extended)
+{
+    height_bitmap instance{};
+    instance.set(500);
+    instance.trim(500);
+    instance.set(10);
+    BOOST_REQUIRE(instance.is_set(10));
+    BOOST_REQUIRE(instance.is_set(500));
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+}
+
+// clear
+
+BOOST_AUTO_TEST_CASE(height_bitmap__clear__set__empty)
+{
+    height_bitmap instance{};
+    instance.set(0, 100);
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.next_unset(0), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(peer_history_tests)
+
+const auto file = std::filesystem::temp_directory_path() /
+    "peer_history_tests.cache";
+
+// set_rate/set_latency/get
+
+BOOST_AUTO_TEST_CASE(peer_history__default__empty)
+{
+    const peer_history instance{ 10 };
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.2.3.4:8333"), 0u);
+
+    peer_history::record value{};
+    BOOST_REQUIRE(!instance.get(value, "1.2.3.4:8333"));
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__zero__ignored)
+{
+    peer_history instance{ 10 };
+    instance.set_rate("1.2.3.4:8333", 0);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__repeated__smoothed)
+{
+    peer_history instance{ 10 };
+    instance.set_rate("1.2.3.4:8333", 400);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.2.3.4:8333"), 400u);
+
+    // (400 * 3 + 800) / 4
+    instance.set_rate("1.2.3.4:8333", 800);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.2.3.4:8333"), 500u);
+    BOOST_REQUIRE_EQUAL(instance.size(), one);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__maximum__no_overflow)
+{
+    peer_history instance{ 10 };
+    instance.set_rate("1.2.3.4:8333", max_uint64);
+    instance.set_rate("1.2.3.4:8333", max_uint64);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.2.3.4:8333"), max_uint64);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_latency__after_rate__both_retained)
+{
+    peer_history instance{ 10 };
+    instance.set_rate("1.2.3.4:8333", 400);
+    instance.set_latency("1.2.3.4:8333", 100);
+    instance.set_latency("1.2.3.4:8333", 200);
+
+    peer_history::record value{};
+    BOOST_REQUIRE(instance.get(value, "1.2.3.4:8333"));
+    BOOST_REQUIRE_EQUAL(value.rate, 400u);
+    BOOST_REQUIRE_EQUAL(value.latency, 125u);
+}
+
+// capacity
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__zero_capacity__empty)
+{
+    peer_history instance{ 0 };
+    instance.set_rate("1.2.3.4:8333", 400);
+    instance.set_latency("1.2.3.4:8333", 100);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__full__oldest_evicted)
+{
+    peer_history instance{ 2 };
+    instance.set_rate("1.1.1.1:8333", 300);
+    instance.set_rate("2.2.2.2:8333", 100);
+    instance.set_rate("3.3.3.3:8333", 200);
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.1.1.1:8333"), 0u);
+    BOOST_REQUIRE_EQUAL(instance.rate("2.2.2.2:8333"), 100u);
+    BOOST_REQUIRE_EQUAL(instance.rate("3.3.3.3:8333"), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_rate__full_updated__least_recent_evicted)
+{
+    peer_history instance{ 2 };
+    instance.set_rate("1.1.1.1:8333", 300);
+    instance.set_rate("2.2.2.2:8333", 100);
+    instance.set_latency("1.1.1.1:8333", 10);
+    instance.set_rate("3.3.3.3:8333", 200);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.1.1.1:8333"), 300u);
+    BOOST_REQUIRE_EQUAL(instance.rate("2.2.2.2:8333"), 0u);
+    BOOST_REQUIRE_EQUAL(instance.rate("3.3.3.3:8333"), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__set_latency__full__latency_only_retained)
+{
+    peer_history instance{ 2 };
+    instance.set_rate("1.1.1.1:8333", 300);
+    instance.set_latency("2.2.2.2:8333", 10);
+    instance.set_rate("3.3.3.3:8333", 200);
+
+    peer_history::record value{};
+    BOOST_REQUIRE(instance.get(value, "2.2.2.2:8333"));
+    BOOST_REQUIRE_EQUAL(value.latency, 10u);
+    BOOST_REQUIRE(!instance.get(value, "1.1.1.1:8333"));
+}
+
+// prefer/next
+
+BOOST_AUTO_TEST_CASE(peer_history__prefer__mixed__fastest_first)
+{
+    peer_history instance{ 10 };
+    instance.set_rate("1.1.1.1:8333", 100);
+    instance.set_rate("2.2.2.2:8333", 300);
+    instance.set_rate("3.3.3.3:8333", 200);
+    instance.set_rate("4.4.4.4:8333", 300);
+    instance.set_latency("2.2.2.2:8333", 50);
+    instance.set_latency("4.4.4.4:8333", 10);
+    instance.set_latency("5.5.5.5:8333", 10);
+    instance.prefer(3);
+
+    std::string peer{};
+    BOOST_REQUIRE(instance.next(peer));
+    BOOST_REQUIRE_EQUAL(peer, "4.4.4.4:8333");
+    BOOST_REQUIRE(instance.next(peer));
+    BOOST_REQUIRE_EQUAL(peer, "2.2.2.2:8333");
+    BOOST_REQUIRE(instance.next(peer));
+    BOOST_REQUIRE_EQUAL(peer, "3.3.3.3:8333");
+    BOOST_REQUIRE(!instance.next(peer));
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__prefer__unmeasured_rates__none)
+{
+    peer_history instance{ 10 };
+    instance.set_latency("1.1.1.1:8333", 10);
+    instance.prefer(3);
+
+    std::string peer{};
+    BOOST_REQUIRE(!instance.next(peer));
+}
+
+// load/save
+
+BOOST_AUTO_TEST_CASE(peer_history__load__missing_file__false)
+{
+    std::filesystem::remove(file);
+    peer_history instance{ 10 };
+    BOOST_REQUIRE(!instance.load(file));
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__save__load__round_trip)
+{
+    peer_history saved{ 10 };
+    saved.set_rate("1.1.1.1:8333", 100);
+    saved.set_rate("[2001:db8::1]:8333", 300);
+    saved.set_latency("[2001:db8::1]:8333", 42);
+    BOOST_REQUIRE(saved.save(file));
+
+    peer_history loaded{ 10 };
+    loaded.set_rate("9.9.9.9:8333", 999);
+    BOOST_REQUIRE(loaded.load(file));
+    BOOST_REQUIRE_EQUAL(loaded.size(), two);
+    BOOST_REQUIRE_EQUAL(loaded.rate("9.9.9.9:8333"), 0u);
+    BOOST_REQUIRE_EQUAL(loaded.rate("1.1.1.1:8333"), 100u);
+
+    peer_history::record value{};
+    BOOST_REQUIRE(loaded.get(value, "[2001:db8::1]:8333"));
+    BOOST_REQUIRE_EQUAL(value.rate, 300u);
+    BOOST_REQUIRE_EQUAL(value.latency, 42u);
+    std::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_CASE(peer_history__load__malformed_and_excess__skipped)
+{
+    {
+        std::ofstream out{ file, std::ios::trunc };
+        out << "1.1.1.1:8333 100 10\n";
+        out << "garbage\n";
+        out << "2.2.2.2:8333 300 20\n";
+        out << "3.3.3.3:8333 200 30\n";
+    }
+
+    peer_history instance{ 2 };
+    BOOST_REQUIRE(instance.load(file));
+    BOOST_REQUIRE_EQUAL(instance.size(), two);
+    BOOST_REQUIRE_EQUAL(instance.rate("1.1.1.1:8333"), 0u);
+    BOOST_REQUIRE_EQUAL(instance.rate("2.2.2.2:8333"), 300u);
+    BOOST_REQUIRE_EQUAL(instance.rate("3.3.3.3:8333"), 200u);
+    std::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
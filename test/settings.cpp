@@ -35,13 +35,26 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
     BOOST_REQUIRE_EQUAL(node.memory_priority, true);
     BOOST_REQUIRE_EQUAL(node.thread_priority, true);
     BOOST_REQUIRE_EQUAL(node.allow_overlapped, true);
+    BOOST_REQUIRE_EQUAL(node.allocation_adaptive, false);
+    BOOST_REQUIRE_EQUAL(node.allocation_huge_pages, false);
+    BOOST_REQUIRE_EQUAL(node.allocation_numa, false);
     BOOST_REQUIRE_EQUAL(node.defer_validation, false);
     BOOST_REQUIRE_EQUAL(node.defer_confirmation, false);
+    BOOST_REQUIRE_EQUAL(node.robust_deviation, false);
+    BOOST_REQUIRE_EQUAL(node.rebalance_work, false);
     BOOST_REQUIRE_EQUAL(node.minimum_fee_rate, 0.0);
     BOOST_REQUIRE_EQUAL(node.minimum_bump_rate, 0.0);
     BOOST_REQUIRE_EQUAL(node.allowed_deviation, 1.5);
     BOOST_REQUIRE_EQUAL(node.announcement_cache, 42_u16);
     BOOST_REQUIRE_EQUAL(node.allocation_multiple, 20_u16);
+    BOOST_REQUIRE_EQUAL(node.pipeline_depth, 2_u16);
+    BOOST_REQUIRE_EQUAL(node.history_preferred, 8_u16);
+    BOOST_REQUIRE_EQUAL(node.current_outbound, 0_u16);
+    BOOST_REQUIRE_EQUAL(node.archive_backlog, 32_u16);
+    BOOST_REQUIRE_EQUAL(node.prefetch_blocks, 16_u16);
+    BOOST_REQUIRE_EQUAL(node.allocation_retain_bytes, 0_u64);
+    BOOST_REQUIRE_EQUAL(node.maximum_window_bytes, 8'000'000'000_u64);
+    BOOST_REQUIRE_EQUAL(node.maximum_window_bytes_(), 8'000'000'000_u64);
     ////BOOST_REQUIRE_EQUAL(node.snapshot_bytes, 200'000'000'000_u64);
     ////BOOST_REQUIRE_EQUAL(node.snapshot_valid, 250'000_u32);
     ////BOOST_REQUIRE_EQUAL(node.snapshot_confirm, 500'000_u32);
@@ -49,7 +62,11 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
     BOOST_REQUIRE_EQUAL(node.maximum_height_(), max_size_t);
     BOOST_REQUIRE_EQUAL(node.maximum_concurrency, 50000_u32);
     BOOST_REQUIRE_EQUAL(node.maximum_concurrency_(), 50000_size);
+    BOOST_REQUIRE_EQUAL(node.history_capacity, 1000_u32);
+    BOOST_REQUIRE_EQUAL(node.parallel_connect, 500_u32);
+    BOOST_REQUIRE_EQUAL(node.archive_threads, 4_u32);
     BOOST_REQUIRE_EQUAL(node.sample_period_seconds, 10_u16);
+    BOOST_REQUIRE_EQUAL(node.endgame_seconds, 5_u16);
     BOOST_REQUIRE_EQUAL(node.currency_window_minutes, 1440_u32);
     BOOST_REQUIRE_EQUAL(node.threads, 1_u32);
 
@@ -57,6 +74,7 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
     BOOST_REQUIRE_EQUAL(node.maximum_height_(), max_size_t);
     BOOST_REQUIRE_EQUAL(node.maximum_concurrency_(), 50'000_size);
     BOOST_REQUIRE(node.sample_period() == steady_clock::duration(seconds(10)));
+    BOOST_REQUIRE(node.endgame_period() == steady_clock::duration(seconds(5)));
     BOOST_REQUIRE(node.currency_window() == steady_clock::duration(minutes(1440)));
     BOOST_REQUIRE(node.thread_priority_() == network::processing_priority::high);
     BOOST_REQUIRE(node.memory_priority_() == network::memory_priority::highest);